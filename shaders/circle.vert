@@ -3,14 +3,16 @@
 #define M_PI 3.1415926535897932384626433832795
 
 layout(location = 0) in float vPosition;
+layout(location = 1) in vec3 vCircle; // Position (xy) and radius (z) of the circle
+layout(location = 2) in vec4 vColor;
 
-uniform vec2 uPosition;
-uniform float uRadius;
+out vec4 fLineColor;
 
 uniform mat4 matView;
 uniform mat4 matProjection;
 
 void main()
 {
-	gl_Position = matProjection * matView * vec4(uPosition.x + uRadius * cos(2 * M_PI * vPosition), uPosition.y + uRadius * sin(2 * M_PI * vPosition), 0.0f, 1.0f);
+	gl_Position = matProjection * matView * vec4(vCircle.x + vCircle.z * cos(2 * M_PI * vPosition), vCircle.y + vCircle.z * sin(2 * M_PI * vPosition), 0.0f, 1.0f);
+	fLineColor = vColor;
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #version 430 core
 
-out vec4 fColor;
+in vec4 fLineColor;
 
-uniform vec4 uColor;
+out vec4 fColor;
 
 void main()
 {
-	fColor = uColor;
+	fColor = fLineColor;
 }
\ No newline at end of file
@@ -1,16 +1,15 @@
 #version 430 core
 
-layout(location = 0) in float vPosition;
+layout(location = 0) in vec2 vPosition;
+layout(location = 1) in vec4 vColor;
 
-uniform vec2 uStart;
-uniform vec2 uEnd;
+out vec4 fLineColor;
 
 uniform mat4 matView;
 uniform mat4 matProjection;
 
 void main()
 {
-	float s = vPosition.x;
-	float e = (1.0f - vPosition.x);
-	gl_Position = matProjection * matView * vec4(s * uStart.x + e * uEnd.x, s * uStart.y + e * uEnd.y, 0.0f, 1.0f);
+	gl_Position = matProjection * matView * vec4(vPosition.x, vPosition.y, 0.0f, 1.0f);
+	fLineColor = vColor;
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #version 430 core
 
 in vec2 fUV;
+flat in vec4 fTransparancyColor;
 
 out vec4 fColor;
 
-uniform vec4 uTransparancyColor;
 uniform sampler2D spriteSampler;
 
 void main()
@@ -13,5 +13,5 @@ void main()
 	fColor = vec4(texture(spriteSampler, fUV).rgb, 1.0f);
 	
 	// Discard fragments with the transparancy color
-	if (fColor == uTransparancyColor) discard;
+	if (fColor == fTransparancyColor) discard;
 }
\ No newline at end of file
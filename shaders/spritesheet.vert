@@ -3,31 +3,47 @@
 layout(location = 0) in vec2 vPosition;
 layout(location = 1) in vec2 vUV; 
 
-out vec2 fUV;
+layout(location = 2) in vec4 vPosRect; // Local bottom-left (xy) and top-right (zw) corners of the sprite
+layout(location = 3) in vec4 vUVRect; // Bottom-left (xy) and top-right (zw) UVs of the frame
+layout(location = 4) in vec4 vTranslationRotation; // Translation (xyz) and rotation (w) of the sprite
+layout(location = 5) in vec2 vScale; // Scale of the sprite
+layout(location = 6) in float vOrder; // Position of the sprite in the draw order
+layout(location = 7) in vec4 vTransparancyColor; // Transparancy color of the sprite sheet
 
-uniform vec2 uPosBottomLeft; 
-uniform vec2 uPosTopRight;
+out vec2 fUV;
+flat out vec4 fTransparancyColor;
 
-uniform vec2 uUVBottomLeft; 
-uniform vec2 uUVTopRight; 
+uniform float uDepthStep; // Depth between consecutive sprites in the draw order
 
-uniform mat4 matModel;
 uniform mat4 matView;
 uniform mat4 matProjection;
 
 void main()
 {
-	// Calculate the position
+	// Calculate the local position
 	float sX = vPosition.x;
 	float eX = (1.0f - vPosition.x);
 	float sY = vPosition.y;
 	float eY = (1.0f - vPosition.y);
-	gl_Position = matProjection * matView * matModel * vec4(sX * uPosBottomLeft.x + eX * uPosTopRight.x, sY * uPosBottomLeft.y + eY * uPosTopRight.y, 0.0f, 1.0f);
+	vec2 position = vec2(sX * vPosRect.x + eX * vPosRect.z, sY * vPosRect.y + eY * vPosRect.w);
+	
+	// Scale, rotate and translate the position
+	position *= vScale;
+	float c = cos(vTranslationRotation.w);
+	float s = sin(vTranslationRotation.w);
+	position = vec2(c * position.x - s * position.y, s * position.x + c * position.y);
+	gl_Position = matProjection * matView * vec4(position + vTranslationRotation.xy, vTranslationRotation.z, 1.0f);
+	
+	// Place sprites that are drawn later in front of the sprites drawn before them
+	gl_Position.z = (1.0f - 2.0f * vOrder * uDepthStep) * gl_Position.w;
 	
 	// Pass the UVs
 	float sX_uv = vUV.x;
 	float eX_uv = (1.0f - vUV.x);
 	float sY_uv = vUV.y;
 	float eY_uv = (1.0f - vUV.y);
-	fUV = vec2(sX_uv * uUVBottomLeft.x + eX_uv * uUVTopRight.x, sY_uv * uUVBottomLeft.y + eY_uv * uUVTopRight.y);
+	fUV = vec2(sX_uv * vUVRect.x + eX_uv * vUVRect.z, sY_uv * vUVRect.y + eY_uv * vUVRect.w);
+	
+	// Pass the transparancy color
+	fTransparancyColor = vTransparancyColor;
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Game.hpp"
 
 #include "debugging\LoggingManager.hpp" // [DEBUGGING] Logging Manager
+#include "jobs\JobManager.hpp" // [JOBS] Job Manager
 #include "graphics\GraphicsManager.hpp" // [GRAPHICS] Graphics Manager
 #include "input\InputManager.hpp" // [INPUT] Input Manager
 #include "audio\AudioManager.hpp" // [AUDIO] Audio Manager
 #include "timing\TimingManager.hpp" // [TIMING] Timing Manager
+#include "world\CollisionManager.hpp" // [WORLD] Collision Manager
 #include "world\WorldManager.hpp" // [WORLD] World Manager
 #include "resources\ResourceManager.hpp" // [RESOURCES] Resource Manager
 
@@ -22,6 +24,8 @@ void Engine::Game::Initialize()
 
 	LoggingManager::Create();
 	LoggingManager::GetInstance().Initialize();
+	JobManager::Create();
+	JobManager::GetInstance().Initialize();
 	AudioManager::Create();
 	AudioManager::GetInstance().Initialize();
 	GraphicsManager::Create();
@@ -30,6 +34,8 @@ void Engine::Game::Initialize()
 	InputManager::GetInstance().Initialize();
 	TimingManager::Create();
 	TimingManager::GetInstance().Initialize();
+	CollisionManager::Create();
+	CollisionManager::GetInstance().Initialize();
 	WorldManager::Create();
 	WorldManager::GetInstance().Initialize();
 	ResourceManager::Create();
@@ -59,12 +65,16 @@ void Engine::Game::Terminate()
 	TimingManager::Destroy();
 	WorldManager::GetInstance().Terminate();
 	WorldManager::Destroy();
+	CollisionManager::GetInstance().Terminate();
+	CollisionManager::Destroy();
 	InputManager::GetInstance().Terminate();
 	InputManager::Destroy();
 	GraphicsManager::GetInstance().Terminate();
 	GraphicsManager::Destroy();
 	AudioManager::GetInstance().Destroy();
 	AudioManager::Destroy();
+	JobManager::GetInstance().Terminate();
+	JobManager::Destroy();
 	LoggingManager::GetInstance().Terminate();
 	LoggingManager::Destroy();
 }
@@ -42,6 +42,15 @@ namespace Engine{
 		inline double GetMeasuredTotalTimeSeconds() const { return (float)m_MeasuredTotalTimeMicros / 1000000.0f; }
 		inline unsigned long long GetFrameCount() const { return m_FrameCount; }
 
+		// Gets the timing information for updates that happen once every number of frames (assumes all skipped frames took as long as the current frame)
+		inline GameTime accumulated(unsigned int frames) const 
+		{ 
+			GameTime gameTime(*this);
+			gameTime.m_DeltaTimeMicros *= frames;
+			gameTime.m_MeasuredDeltaTimeMicros *= frames;
+			return gameTime;
+		}
+
 		// Updates the timing information and continues (variable framerate)
 		inline void update() 
 		{ 
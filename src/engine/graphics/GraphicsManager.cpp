@@ -10,6 +10,8 @@
 
 #include <fstream> // For reading shaders from file
 #include <sstream> // String streams for parsing shader files
+#include <algorithm> // For ordering the sprites at a layer and z as they were drawn
+#include <cstddef> // For the offsets of the vertex and instance attributes
 
 // Initializes GLFW, GLEW and creates a window for rendering
 void Engine::GraphicsManager::Initialize()
@@ -38,11 +40,31 @@ void Engine::GraphicsManager::Initialize()
 	m_CameraZoom = 1.0f;
 	m_CameraViewMatrixDirty = true;
 	m_CameraProjectionMatrixDirty = true;
+
+	// Initialize the render queue and its streaming buffers
+	m_RecordFrame = &m_RenderFrames[0];
+	m_SubmitFrame = NULL;
+	m_RenderLayer = 0;
+	m_LineCapacity = 0;
+	m_CircleCapacity = 0;
+	m_SpriteCapacity = 0;
+	m_SpriteDepth = 0;
+
+	// Submit draw commands on the game thread until the render thread is enabled
+	m_RenderThreadEnabled = false;
+	m_RenderThreadStopping = false;
+	m_RenderTasksQueued = 0;
+	m_RenderTasksRun = 0;
 }
 
 // Destroys the window for rendering and GLEW and GLFW
 void Engine::GraphicsManager::Terminate()
 {
+	// Take the OpenGL context back from the render thread, and release the OpenGL objects of draw commands that were never submitted
+	SetRenderThread(false);
+	for (const std::function<void()>& release : m_RecordFrame->m_Releases) { release(); }
+	m_RecordFrame->m_Releases.clear();
+
 	// Destroy standard shader programs
 	TerminateShaderPrograms();
 
@@ -53,8 +75,8 @@ void Engine::GraphicsManager::Terminate()
 // Swaps the buffers of the main window
 void Engine::GraphicsManager::SwapWindowBuffers()
 {
-	glfwSwapBuffers(m_Window);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	// Hand off the recorded draw commands, which swap the buffers once they are submitted
+	HandOffRenderFrame(true);
 }
 
 // Initializes GLFW
@@ -72,6 +94,7 @@ bool Engine::GraphicsManager::InitializeGLFW()
 	glfwWindowHint(GLFW_DECORATED, GL_TRUE);
 	glfwWindowHint(GLFW_FOCUSED, GL_TRUE);
 	glfwWindowHint(GLFW_DOUBLEBUFFER, GL_TRUE); // Prevent screen tearing
+	glfwWindowHint(GLFW_DEPTH_BITS, 24); // Keep the draw order of batched sprites
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // Prevent the use of deprecated OpenGL functionality
@@ -131,38 +154,20 @@ void Engine::GraphicsManager::InitializeShaderPrograms()
 {
 	//////////////////////////////////////////////////// Line Shader
 	m_ShaderLine = LoadShaderProgram("line", "flatColor");
-	m_ShaderLine_uColor = glGetUniformLocation(m_ShaderLine, "uColor");
-	m_ShaderLine_uStart = glGetUniformLocation(m_ShaderLine, "uStart");
-	m_ShaderLine_uEnd = glGetUniformLocation(m_ShaderLine, "uEnd");
 	m_ShaderLine_uMatView = glGetUniformLocation(m_ShaderLine, "matView");
 	m_ShaderLine_uMatProjection = glGetUniformLocation(m_ShaderLine, "matProjection");
 
-	/////////////////////////////////////////////// Rectangle Shader
-	m_ShaderRectangle = LoadShaderProgram("rectangle", "flatColor");
-	m_ShaderRectangle_uColor = glGetUniformLocation(m_ShaderRectangle, "uColor");
-	m_ShaderRectangle_uBottomLeft = glGetUniformLocation(m_ShaderRectangle, "uBottomLeft");
-	m_ShaderRectangle_uTopRight = glGetUniformLocation(m_ShaderRectangle, "uTopRight");
-	m_ShaderRectangle_uMatView = glGetUniformLocation(m_ShaderRectangle, "matView");
-	m_ShaderRectangle_uMatProjection = glGetUniformLocation(m_ShaderRectangle, "matProjection");
-
 	////////////////////////////////////////////////// Circle Shader
 	m_ShaderCircle = LoadShaderProgram("circle", "flatColor");
-	m_ShaderCircle_uColor = glGetUniformLocation(m_ShaderCircle, "uColor");
-	m_ShaderCircle_uPosition = glGetUniformLocation(m_ShaderCircle, "uPosition");
-	m_ShaderCircle_uRadius = glGetUniformLocation(m_ShaderCircle, "uRadius");
 	m_ShaderCircle_uMatView = glGetUniformLocation(m_ShaderCircle, "matView");
 	m_ShaderCircle_uMatProjection = glGetUniformLocation(m_ShaderCircle, "matProjection");
 
 	//////////////////////////////////////////// Sprite Sheet Shader
 	m_ShaderSpriteSheet = LoadShaderProgram("spritesheet", "spritesheet");
-	m_ShaderSpriteSheet_uTransparancyColor = glGetUniformLocation(m_ShaderSpriteSheet, "uTransparancyColor");
-	m_ShaderSpriteSheet_uPosBottomLeft = glGetUniformLocation(m_ShaderSpriteSheet, "uPosBottomLeft");
-	m_ShaderSpriteSheet_uPosTopRight = glGetUniformLocation(m_ShaderSpriteSheet, "uPosTopRight");
-	m_ShaderSpriteSheet_uUVBottomLeft = glGetUniformLocation(m_ShaderSpriteSheet, "uUVBottomLeft");
-	m_ShaderSpriteSheet_uUVTopRight = glGetUniformLocation(m_ShaderSpriteSheet, "uUVTopRight");
-	m_ShaderSpriteSheet_uMatModel = glGetUniformLocation(m_ShaderSpriteSheet, "matModel");
+	m_ShaderSpriteSheet_uDepthStep = glGetUniformLocation(m_ShaderSpriteSheet, "uDepthStep");
 	m_ShaderSpriteSheet_uMatView = glGetUniformLocation(m_ShaderSpriteSheet, "matView");
 	m_ShaderSpriteSheet_uMatProjection = glGetUniformLocation(m_ShaderSpriteSheet, "matProjection");
+	m_ShaderSpriteSheet_uSpriteSampler = glGetUniformLocation(m_ShaderSpriteSheet, "spriteSampler");
 
 	//////////////////////////////////////// Bitmap Font Text Shader
 	m_ShaderTextBitmapFont = LoadShaderProgram("textBitmapFont", "textBitmapFont");
@@ -208,7 +213,6 @@ void Engine::GraphicsManager::InitializeShaderPrograms()
 void Engine::GraphicsManager::TerminateShaderPrograms()
 {
 	glDeleteProgram(m_ShaderLine);
-	glDeleteProgram(m_ShaderRectangle);
 	glDeleteProgram(m_ShaderCircle);
 	glDeleteProgram(m_ShaderSpriteSheet);
 	glDeleteProgram(m_ShaderTextBitmapFont);
@@ -222,33 +226,15 @@ void Engine::GraphicsManager::InitializeBuffers()
 	glGenVertexArrays(1, &m_ShaderLine_VAO);
 	glBindVertexArray(m_ShaderLine_VAO);
 
-	// Generate and bind the vertex buffer
+	// Generate and bind the vertex buffer (streamed when the primitives are flushed)
 	glGenBuffers(1, &m_ShaderLine_VBO);
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderLine_VBO);
 
-	// Buffer vertex data
-	GLfloat vertexDataLine[2] = { 0.0f, 1.0f };
-	glBufferData(GL_ARRAY_BUFFER, 2 * sizeof(GLfloat), &vertexDataLine[0], GL_STATIC_DRAW);
-
-	// Specify the vertex attributes (position)
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 0, (void*)(0)); // Position
-
-	/////////////////////////////////////////////// Rectangle shader
-	glGenVertexArrays(1, &m_ShaderRectangle_VAO);
-	glBindVertexArray(m_ShaderRectangle_VAO);
-
-	// Generate and bind the vertex buffer
-	glGenBuffers(1, &m_ShaderRectangle_VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderRectangle_VBO);
-
-	// Buffer vertex data
-	GLfloat vertexDataRectangle[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-	glBufferData(GL_ARRAY_BUFFER, 4 * 2 * sizeof(GLfloat), &vertexDataRectangle[0], GL_STATIC_DRAW);
-
-	// Specify the vertex attributes (position)
+	// Specify the vertex attributes (position and color)
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)(0)); // Position
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)(offsetof(LineVertex, m_Position))); // Position
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)(offsetof(LineVertex, m_Color))); // Color
 
 	////////////////////////////////////////////////// Circle shader
 	glGenVertexArrays(1, &m_ShaderCircle_VAO);
@@ -267,6 +253,18 @@ void Engine::GraphicsManager::InitializeBuffers()
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 0, (void*)(0)); // Position
 
+	// Generate and bind the instance buffer (streamed when the primitives are flushed)
+	glGenBuffers(1, &m_ShaderCircle_VBO_Instances);
+	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderCircle_VBO_Instances);
+
+	// Specify the instance attributes (position + radius and color)
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(offsetof(CircleInstance, m_Position))); // Position and radius
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(offsetof(CircleInstance, m_Color))); // Color
+	glVertexAttribDivisor(2, 1);
+
 	//////////////////////////////////////////// Sprite sheet shader
 	glGenVertexArrays(1, &m_ShaderSpriteSheet_VAO);
 	glBindVertexArray(m_ShaderSpriteSheet_VAO);
@@ -300,6 +298,14 @@ void Engine::GraphicsManager::InitializeBuffers()
 	glEnableVertexAttribArray(1);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, (void*)(2 * 6 * sizeof(GLfloat))); // UVs
 
+	// Generate the instance buffer (filled and pointed to when the sprite batch is flushed)
+	glGenBuffers(1, &m_ShaderSpriteSheet_VBO_Instances);
+	for (GLuint attribute = 2; attribute <= 7; attribute++)
+	{
+		glEnableVertexAttribArray(attribute);
+		glVertexAttribDivisor(attribute, 1);
+	}
+
 	//////////////////////////////////////// Bitmap font text shader
 	glGenVertexArrays(1, &m_ShaderTextBitmapFont_VAO);
 	glBindVertexArray(m_ShaderTextBitmapFont_VAO);
@@ -445,13 +451,12 @@ void Engine::GraphicsManager::TerminateBuffers()
 	glDeleteBuffers(1, &m_ShaderLine_VBO);
 	glDeleteVertexArrays(1, &m_ShaderLine_VAO);
 
-	glDeleteBuffers(1, &m_ShaderRectangle_VBO);
-	glDeleteVertexArrays(1, &m_ShaderRectangle_VAO);
-
 	glDeleteBuffers(1, &m_ShaderCircle_VBO);
+	glDeleteBuffers(1, &m_ShaderCircle_VBO_Instances);
 	glDeleteVertexArrays(1, &m_ShaderCircle_VAO);
 
 	glDeleteBuffers(1, &m_ShaderSpriteSheet_VBO);
+	glDeleteBuffers(1, &m_ShaderSpriteSheet_VBO_Instances);
 	glDeleteVertexArrays(1, &m_ShaderSpriteSheet_VAO);
 
 	glDeleteBuffers(1, &m_ShaderTextBitmapFont_VBO);
@@ -578,6 +583,13 @@ float Engine::GraphicsManager::GetCameraZoom()
 	return m_CameraZoom;
 }
 
+// Gets the area of the world that is visible through the camera
+Engine::aabb2Df Engine::GraphicsManager::GetCameraView()
+{
+	f2 extent((m_WindowWidth / 2.0f) / m_CameraZoom, (m_WindowHeight / 2.0f) / m_CameraZoom);
+	return aabb2Df(m_CameraPosition - extent, m_CameraPosition + extent);
+}
+
 // Gets the camera's view matrix
 const Engine::mat4f& Engine::GraphicsManager::GetCameraViewMatrix()
 {
@@ -614,6 +626,238 @@ const Engine::mat4f& Engine::GraphicsManager::GetCameraProjectionMatrix()
 	return m_CameraProjectionMatrix;
 }
 
+////////////////////////////////////////////////////////////////
+// Render queue                                               //
+////////////////////////////////////////////////////////////////
+
+// Sorts and draws all recorded draw commands (drawing recorded afterwards ends up on top)
+void Engine::GraphicsManager::FlushRenderQueue()
+{
+	HandOffRenderFrame(false);
+}
+
+// Gets the numbers of draw calls and state changes of the last frame, before and after sorting
+Engine::RenderStatistics Engine::GraphicsManager::GetRenderStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_RenderMutex);
+	return m_RenderStatistics;
+}
+
+// Sorts and submits the draw commands of a render frame (on the thread that owns the OpenGL context)
+void Engine::GraphicsManager::SubmitRenderFrame(RenderFrame& frame)
+{
+	size_t numCommands = frame.m_Queue.size();
+	if (numCommands > 0)
+	{
+		// Sort the draw commands, and count the draw calls and state changes before and after sorting
+		size_t drawCalls, stateChanges;
+		frame.m_Queue.CountDrawCalls(drawCalls, stateChanges);
+		m_FrameStatistics.m_DrawCallsUnsorted += drawCalls;
+		m_FrameStatistics.m_StateChangesUnsorted += stateChanges;
+		frame.m_Queue.Sort();
+		frame.m_Queue.CountDrawCalls(drawCalls, stateChanges);
+		m_FrameStatistics.m_DrawCalls += drawCalls;
+		m_FrameStatistics.m_StateChanges += stateChanges;
+		m_FrameStatistics.m_Commands += numCommands;
+
+		// Start over in the depth buffer if the sprites would run out of depth
+		if (m_SpriteDepth + frame.m_SpriteInstances.size() > s_MaxSpriteDepth)
+		{
+			glClear(GL_DEPTH_BUFFER_BIT);
+			m_SpriteDepth = 0;
+		}
+
+		// Gather the data of the draw commands in the sorted order
+		m_SpriteUpload.clear();
+		m_LineUpload.clear();
+		m_CircleUpload.clear();
+		for (size_t i = 0; i < numCommands; i++)
+		{
+			const RenderCommand& command = frame.m_Queue[i];
+			switch (RenderQueue::GetProgram(command.m_Key))
+			{
+			case RenderQueue::Program::SPRITE_SHEET:
+			{
+				// The sprites at a layer and z come first, number them in the order they were drawn in
+				size_t last = i;
+				m_SpriteSequences.clear();
+				while (last < numCommands && RenderQueue::LayerAndZ(frame.m_Queue[last].m_Key) == RenderQueue::LayerAndZ(command.m_Key) && RenderQueue::GetProgram(frame.m_Queue[last].m_Key) == RenderQueue::Program::SPRITE_SHEET)
+				{
+					m_SpriteSequences.push_back(std::make_pair(RenderQueue::GetSequence(frame.m_Queue[last].m_Key), m_SpriteUpload.size()));
+					m_SpriteUpload.push_back(frame.m_SpriteInstances[frame.m_Queue[last].m_First]);
+					last++;
+				}
+				std::sort(m_SpriteSequences.begin(), m_SpriteSequences.end());
+				for (size_t j = 0; j < m_SpriteSequences.size(); j++) { m_SpriteUpload[m_SpriteSequences[j].second].m_Order = (GLfloat)(++m_SpriteDepth); }
+				i = last - 1;
+				break;
+			}
+			case RenderQueue::Program::LINE:
+				m_LineUpload.insert(m_LineUpload.end(), frame.m_LineVertices.begin() + command.m_First, frame.m_LineVertices.begin() + command.m_First + command.m_Count);
+				break;
+			case RenderQueue::Program::CIRCLE:
+				m_CircleUpload.push_back(frame.m_CircleInstances[command.m_First]);
+				break;
+			default:
+				break;
+			}
+		}
+
+		// Stream the data into the buffers (orphaning the previous contents, or growing the buffers)
+		if (!m_SpriteUpload.empty())
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_ShaderSpriteSheet_VBO_Instances);
+			if (m_SpriteUpload.size() > m_SpriteCapacity) { m_SpriteCapacity = m_SpriteUpload.size() * 2; }
+			glBufferData(GL_ARRAY_BUFFER, m_SpriteCapacity * sizeof(SpriteInstance), NULL, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, m_SpriteUpload.size() * sizeof(SpriteInstance), &m_SpriteUpload[0]);
+		}
+		if (!m_LineUpload.empty())
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_ShaderLine_VBO);
+			if (m_LineUpload.size() > m_LineCapacity) { m_LineCapacity = m_LineUpload.size() * 2; }
+			glBufferData(GL_ARRAY_BUFFER, m_LineCapacity * sizeof(LineVertex), NULL, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, m_LineUpload.size() * sizeof(LineVertex), &m_LineUpload[0]);
+		}
+		if (!m_CircleUpload.empty())
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_ShaderCircle_VBO_Instances);
+			if (m_CircleUpload.size() > m_CircleCapacity) { m_CircleCapacity = m_CircleUpload.size() * 2; }
+			glBufferData(GL_ARRAY_BUFFER, m_CircleCapacity * sizeof(CircleInstance), NULL, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, m_CircleUpload.size() * sizeof(CircleInstance), &m_CircleUpload[0]);
+		}
+
+		// Submit the draw commands, as one draw call for every run of commands with the same program and texture
+		size_t sprite = 0, lineVertex = 0, circle = 0;
+		size_t first = 0;
+		while (first < numCommands)
+		{
+			RenderKey key = frame.m_Queue[first].m_Key;
+			RenderQueue::Program program = RenderQueue::GetProgram(key);
+			GLuint texture = (program == RenderQueue::Program::SPRITE_SHEET) ? frame.m_SpriteTextures[frame.m_Queue[first].m_First] : 0;
+			size_t last = first + 1;
+			size_t count = frame.m_Queue[first].m_Count;
+			while (last < numCommands && RenderQueue::IsBatched(frame.m_Queue[last - 1].m_Key, frame.m_Queue[last].m_Key) && (program != RenderQueue::Program::SPRITE_SHEET || frame.m_SpriteTextures[frame.m_Queue[last].m_First] == texture))
+			{
+				count += frame.m_Queue[last].m_Count;
+				last++;
+			}
+
+			switch (program)
+			{
+			case RenderQueue::Program::SPRITE_SHEET:
+			{
+				UseRenderProgram(program, frame);
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LESS);
+
+				// Point the instance attributes at the sprites of the run
+				size_t offset = sprite * sizeof(SpriteInstance);
+				glBindBuffer(GL_ARRAY_BUFFER, m_ShaderSpriteSheet_VBO_Instances);
+				glBindVertexArray(m_ShaderSpriteSheet_VAO);
+				glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_Positions))); // Positions
+				glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_UVs))); // UVs
+				glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_Translation))); // Translation and rotation
+				glVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_Scale))); // Scale
+				glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_Order))); // Draw order
+				glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, m_TransparancyColor))); // Transparancy color
+
+				// Draw the sprites
+				glBindTexture(GL_TEXTURE_2D, texture);
+				glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)count);
+				glDisable(GL_DEPTH_TEST);
+				sprite += count;
+				break;
+			}
+			case RenderQueue::Program::LINE:
+				UseRenderProgram(program, frame);
+				glBindVertexArray(m_ShaderLine_VAO);
+				glDrawArrays(GL_LINES, (GLint)lineVertex, (GLsizei)count);
+				lineVertex += count;
+				break;
+			case RenderQueue::Program::CIRCLE:
+			{
+				UseRenderProgram(program, frame);
+
+				// Point the instance attributes at the circles of the run
+				size_t offset = circle * sizeof(CircleInstance);
+				glBindBuffer(GL_ARRAY_BUFFER, m_ShaderCircle_VBO_Instances);
+				glBindVertexArray(m_ShaderCircle_VAO);
+				glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(offset + offsetof(CircleInstance, m_Position))); // Position and radius
+				glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(offset + offsetof(CircleInstance, m_Color))); // Color
+				glDrawArraysInstanced(GL_LINE_LOOP, 0, s_NumCircleSegments, (GLsizei)count);
+				circle += count;
+				break;
+			}
+			case RenderQueue::Program::TEXT_BITMAP_FONT:
+				SubmitText(frame.m_TextCommands[frame.m_Queue[first].m_First], frame);
+				break;
+			case RenderQueue::Program::TEXT_BITMAP_FONT_ADVANCED:
+				SubmitTextAdvanced(frame.m_TextCommands[frame.m_Queue[first].m_First], frame);
+				break;
+			}
+			glBindVertexArray(0);
+			first = last;
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	// Clear the recorded draw commands and their data
+	frame.m_Queue.Clear();
+	frame.m_LineVertices.clear();
+	frame.m_CircleInstances.clear();
+	frame.m_SpriteInstances.clear();
+	frame.m_SpriteTextures.clear();
+	frame.m_TextCommands.clear();
+	frame.m_TextPositions.clear();
+	frame.m_TextGlyphs.clear();
+	frame.m_TextColors.clear();
+	frame.m_TextAnimations.clear();
+
+	// Release the OpenGL objects that are no longer drawn (the draw commands that could refer to them have been submitted)
+	for (const std::function<void()>& release : frame.m_Releases) { release(); }
+	frame.m_Releases.clear();
+
+	// Swap the buffers at the end of the frame, and keep the statistics of the frame
+	if (frame.m_SwapBuffers)
+	{
+		glfwSwapBuffers(m_Window);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		m_SpriteDepth = 0;
+
+		std::lock_guard<std::mutex> lock(m_RenderMutex);
+		m_RenderStatistics = m_FrameStatistics;
+		m_FrameStatistics = RenderStatistics();
+	}
+}
+
+// Uses a shader program for drawing from the render queue, and passes the transformation matrices of the render frame
+void Engine::GraphicsManager::UseRenderProgram(RenderQueue::Program program, const RenderFrame& frame)
+{
+	switch (program)
+	{
+	case RenderQueue::Program::SPRITE_SHEET:
+		glUseProgram(m_ShaderSpriteSheet);
+		glActiveTexture(GL_TEXTURE0);
+		glUniform1i(m_ShaderSpriteSheet_uSpriteSampler, 0);
+		glUniform1f(m_ShaderSpriteSheet_uDepthStep, 1.0f / s_MaxSpriteDepth);
+		glUniformMatrix4fv(m_ShaderSpriteSheet_uMatView, 1, GL_FALSE, (GLfloat*)(&frame.m_ViewMatrix));
+		glUniformMatrix4fv(m_ShaderSpriteSheet_uMatProjection, 1, GL_FALSE, (GLfloat*)(&frame.m_ProjectionMatrix));
+		break;
+	case RenderQueue::Program::LINE:
+		glUseProgram(m_ShaderLine);
+		glUniformMatrix4fv(m_ShaderLine_uMatView, 1, GL_FALSE, (GLfloat*)(&frame.m_ViewMatrix));
+		glUniformMatrix4fv(m_ShaderLine_uMatProjection, 1, GL_FALSE, (GLfloat*)(&frame.m_ProjectionMatrix));
+		break;
+	case RenderQueue::Program::CIRCLE:
+		glUseProgram(m_ShaderCircle);
+		glUniformMatrix4fv(m_ShaderCircle_uMatView, 1, GL_FALSE, (GLfloat*)(&frame.m_ViewMatrix));
+		glUniformMatrix4fv(m_ShaderCircle_uMatProjection, 1, GL_FALSE, (GLfloat*)(&frame.m_ProjectionMatrix));
+		break;
+	default:
+		break;
+	}
+}
+
 ////////////////////////////////////////////////////////////////
 // Sprite sheets                                              //
 ////////////////////////////////////////////////////////////////
@@ -624,46 +868,36 @@ void Engine::GraphicsManager::DrawSpriteSheetFrame(SpriteSheet spriteSheet, unsi
 	// Retrieve the sprite sheet resource from the ResourceManager
 	SpriteSheetResource& spriteSheetResource = ResourceManager::GetInstance().GetSpriteSheetResource(spriteSheet);
 
-	// Use the sprite sheet shader program
-	glUseProgram(m_ShaderSpriteSheet);
-
-	// Bind the sprite sheet texture
-	glActiveTexture(GL_TEXTURE0);
-	glUniform1i(glGetUniformLocation(m_ShaderSpriteSheet, "spriteSampler"), 0);
-	glBindTexture(GL_TEXTURE_2D, ResourceManager::GetInstance().GetImageResource(spriteSheetResource.m_Image).GetTexture());
+	// Get the texture the sprite sheet is drawn from (which can be a page of the texture atlas), and the layout of the sheet within it
+	i2 sheetOrigin, sheetSize;
+	GLuint texture = spriteSheetResource.GetTexture(sheetOrigin, sheetSize);
 
-	// Calculate and pass the local coordinates of the sprite
-	f2 posBottomLeft, posTopRight;
+	// Calculate the local coordinates of the sprite and the UVs of the sprite within the texture
+	f2 posBottomLeft, posTopRight, uvBottomLeft, uvTopRight;
 	spriteSheetResource.CalculatePositions(posBottomLeft, posTopRight);
-	glUniform2f(m_ShaderSpriteSheet_uPosBottomLeft, posBottomLeft.x(), posBottomLeft.y());
-	glUniform2f(m_ShaderSpriteSheet_uPosTopRight, posTopRight.x(), posTopRight.y());
-
-	// Calculate and pass the UVs of the sprite within the sprite sheet
-	f2 uvBottomLeft, uvTopRight;
-	spriteSheetResource.CalculateUVs(frame, uvBottomLeft, uvTopRight);
-	glUniform2f(m_ShaderSpriteSheet_uUVBottomLeft, uvBottomLeft.x(), uvBottomLeft.y());
-	glUniform2f(m_ShaderSpriteSheet_uUVTopRight, uvTopRight.x(), uvTopRight.y());
-
-	// Pass the transparancy color information
-	glUniform4f(m_ShaderSpriteSheet_uTransparancyColor,
-		spriteSheetResource.m_Metadata.m_ColorTransparancyRed / 255.0f,
-		spriteSheetResource.m_Metadata.m_ColorTransparancyGreen / 255.0f,
-		spriteSheetResource.m_Metadata.m_ColorTransparancyBlue / 255.0f,
-		spriteSheetResource.m_Metadata.m_ColorTransparancyAlpha / 255.0f);
-
-	// Pass the transformation matrices
-	glm::mat4x4 matModel = glm::translate(glm::mat4x4(), (glm::vec3)translation);
-	if (rotation != 0.0f) { matModel = glm::rotate(matModel, (float)rotation, glm::vec3(0.0f, 0.0f, 1.0f)); }
-	if (scale != f2(1.0f, 1.0f)) { matModel = glm::scale(matModel, glm::vec3(scale.x(), scale.y(), 1.0f)); }
-	glUniformMatrix4fv(m_ShaderSpriteSheet_uMatModel, 1, GL_FALSE, glm::value_ptr(matModel));
-	glUniformMatrix4fv(m_ShaderSpriteSheet_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-	glUniformMatrix4fv(m_ShaderSpriteSheet_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
-
-	// Draw the sprite sheet frame
-	// glBindVertexArray(spriteSheetResource.m_VertexAttributes);
-	glBindVertexArray(m_ShaderSpriteSheet_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+	spriteSheetResource.CalculateUVs(frame, sheetOrigin, sheetSize, uvBottomLeft, uvTopRight);
+
+	// Record the sprite
+	ReserveRenderCommand();
+	RecordRenderCommand(RenderQueue::Program::SPRITE_SHEET, translation.z(), texture, m_RecordFrame->m_SpriteInstances.size(), 1);
+	SpriteInstance instance = 
+	{
+		{ posBottomLeft.x(), posBottomLeft.y(), posTopRight.x(), posTopRight.y() },
+		{ uvBottomLeft.x(), uvBottomLeft.y(), uvTopRight.x(), uvTopRight.y() },
+		{ translation.x(), translation.y(), translation.z() },
+		rotation,
+		{ scale.x(), scale.y() },
+		0.0f,
+		0.0f,
+		{
+			spriteSheetResource.m_Metadata.m_ColorTransparancyRed / 255.0f,
+			spriteSheetResource.m_Metadata.m_ColorTransparancyGreen / 255.0f,
+			spriteSheetResource.m_Metadata.m_ColorTransparancyBlue / 255.0f,
+			spriteSheetResource.m_Metadata.m_ColorTransparancyAlpha / 255.0f
+		}
+	};
+	m_RecordFrame->m_SpriteInstances.push_back(instance);
+	m_RecordFrame->m_SpriteTextures.push_back(texture);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -673,11 +907,57 @@ void Engine::GraphicsManager::DrawSpriteSheetFrame(SpriteSheet spriteSheet, unsi
 // Draws a text message using the specified bitmap font
 void Engine::GraphicsManager::DrawText(const std::string& text, BitmapFont font, transform2D transform, float z, const colorRGBA& color)
 {
-	// Retrieve the bitmap font resource from the ResourceManager
-	BitmapFontResource& bitmapFontResource = ResourceManager::GetInstance().GetBitmapFontResource(font);
+	RecordText(RenderQueue::Program::TEXT_BITMAP_FONT, text, font, transform, z, color);
+}
 
-	// Retrieve the sprite sheet resource from the ResourceManager
+// Draws a text message using the specified bitmap font (supports color tags)
+void Engine::GraphicsManager::DrawTextAdvanced(const std::string& text, BitmapFont font, transform2D transform, float z, const colorRGBA& defaultColor)
+{
+	RecordText(RenderQueue::Program::TEXT_BITMAP_FONT_ADVANCED, text, font, transform, z, defaultColor);
+}
+
+// Records a text message
+void Engine::GraphicsManager::RecordText(RenderQueue::Program program, const std::string& text, BitmapFont font, const transform2D& transform, float z, const colorRGBA& color)
+{
+	// Retrieve the bitmap font resource and its sprite sheet resource from the ResourceManager
+	BitmapFontResource& bitmapFontResource = ResourceManager::GetInstance().GetBitmapFontResource(font);
 	SpriteSheetResource& spriteSheetResource = ResourceManager::GetInstance().GetSpriteSheetResource(bitmapFontResource.m_SpriteSheet);
+	i2 sheetOrigin, sheetSize;
+	GLuint texture = spriteSheetResource.GetTexture(sheetOrigin, sheetSize);
+
+	// Calculate the character data now, so the text is submitted without its resources
+	ReserveRenderCommand();
+	RenderFrame& frame = *m_RecordFrame;
+	size_t firstCharacter = frame.m_TextPositions.size();
+	size_t firstStyle = frame.m_TextColors.size();
+	if (program == RenderQueue::Program::TEXT_BITMAP_FONT_ADVANCED) { bitmapFontResource.GetCharacterDataAdvanced(text, frame.m_TextPositions, frame.m_TextGlyphs, frame.m_TextColors, frame.m_TextAnimations, color); }
+	else { bitmapFontResource.GetCharacterData(text, frame.m_TextPositions, frame.m_TextGlyphs); }
+	size_t numCharacters = frame.m_TextPositions.size() - firstCharacter;
+	if (numCharacters == 0) { return; }
+
+	const SpriteSheetResource::Metadata& metadata = spriteSheetResource.m_Metadata;
+	TextCommand command;
+	command.m_Texture = texture;
+	command.m_GlyphSize = i2(metadata.m_SpriteWidth, metadata.m_SpriteHeight);
+	command.m_GlyphOrigin = i2(metadata.m_SpriteOriginX, metadata.m_SpriteOriginY);
+	command.m_SheetGridSize = i2(metadata.m_SheetColumns, metadata.m_SheetRows);
+	command.m_SheetSeparation = i2(metadata.m_SheetSeparationX, metadata.m_SheetSeparationY);
+	command.m_SheetOrigin = sheetOrigin;
+	command.m_SheetSize = sheetSize;
+	command.m_Transform = transform;
+	command.m_Color = color;
+	command.m_FirstCharacter = firstCharacter;
+	command.m_NumCharacters = numCharacters;
+	command.m_FirstStyle = firstStyle;
+	RecordRenderCommand(program, z, texture, frame.m_TextCommands.size(), 1);
+	frame.m_TextCommands.push_back(command);
+}
+
+// Submits a recorded text message
+void Engine::GraphicsManager::SubmitText(const TextCommand& command, const RenderFrame& frame)
+{
+	transform2D transform = command.m_Transform;
+	const colorRGBA& color = command.m_Color;
 
 	// Use the sprite sheet shader program
 	glUseProgram(m_ShaderTextBitmapFont);
@@ -685,34 +965,30 @@ void Engine::GraphicsManager::DrawText(const std::string& text, BitmapFont font,
 	// Bind the sprite sheet texture
 	glActiveTexture(GL_TEXTURE0);
 	glUniform1i(m_ShaderTextBitmapFont_uSpriteSampler, 0);
-	glBindTexture(GL_TEXTURE_2D, ResourceManager::GetInstance().GetImageResource(spriteSheetResource.m_Image).GetTexture());
+	glBindTexture(GL_TEXTURE_2D, command.m_Texture);
 
 	// Pass the bitmap font data
-	glUniform2i(m_ShaderTextBitmapFont_uGlyphSize, spriteSheetResource.m_Metadata.m_SpriteWidth, spriteSheetResource.m_Metadata.m_SpriteHeight);
-	glUniform2i(m_ShaderTextBitmapFont_uGlyphOrigin, spriteSheetResource.m_Metadata.m_SpriteOriginX, spriteSheetResource.m_Metadata.m_SpriteOriginY);
-	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetGridSize, spriteSheetResource.m_Metadata.m_SheetColumns, spriteSheetResource.m_Metadata.m_SheetRows);
-	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetSize, spriteSheetResource.m_Metadata.m_SheetWidth, spriteSheetResource.m_Metadata.m_SheetHeight);
-	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetSeparation, spriteSheetResource.m_Metadata.m_SheetSeparationX, spriteSheetResource.m_Metadata.m_SheetSeparationY);
-	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetOrigin, spriteSheetResource.m_Metadata.m_SheetLeft, spriteSheetResource.m_Metadata.m_SheetTop);
+	glUniform2i(m_ShaderTextBitmapFont_uGlyphSize, command.m_GlyphSize.x(), command.m_GlyphSize.y());
+	glUniform2i(m_ShaderTextBitmapFont_uGlyphOrigin, command.m_GlyphOrigin.x(), command.m_GlyphOrigin.y());
+	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetGridSize, command.m_SheetGridSize.x(), command.m_SheetGridSize.y());
+	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetSize, command.m_SheetSize.x(), command.m_SheetSize.y());
+	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetSeparation, command.m_SheetSeparation.x(), command.m_SheetSeparation.y());
+	glUniform2i(m_ShaderTextBitmapFont_uSpriteSheetOrigin, command.m_SheetOrigin.x(), command.m_SheetOrigin.y());
 
 	// Calculate and pass the transformation matrices
 	glUniformMatrix4fv(m_ShaderTextBitmapFont_uMatModel, 1, GL_FALSE, (GLfloat*)(&transform.GetTransformationMatrix()));
-	glUniformMatrix4fv(m_ShaderTextBitmapFont_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-	glUniformMatrix4fv(m_ShaderTextBitmapFont_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
+	glUniformMatrix4fv(m_ShaderTextBitmapFont_uMatView, 1, GL_FALSE, (GLfloat*)(&frame.m_ViewMatrix));
+	glUniformMatrix4fv(m_ShaderTextBitmapFont_uMatProjection, 1, GL_FALSE, (GLfloat*)(&frame.m_ProjectionMatrix));
 
 	// Pass the text color
 	glUniform4f(m_ShaderTextBitmapFont_uColor, color.r(), color.g(), color.b(), color.a());
 
-	// Calculate and pass the character data
-	std::vector<f2> characterPositions;
-	std::vector<unsigned int> glyphIndices;
-	bitmapFontResource.GetCharacterData(text, characterPositions, glyphIndices);
-	size_t numCharacters = characterPositions.size();
-
+	// Pass the character data (calculated when the text was recorded)
+	size_t numCharacters = command.m_NumCharacters;
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFont_VBO_CharacterPosition);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * 2 * sizeof(GLfloat), &characterPositions[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * 2 * sizeof(GLfloat), &frame.m_TextPositions[command.m_FirstCharacter], GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFont_VBO_GlyphIndex);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * 1 * sizeof(GLuint), &glyphIndices[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * 1 * sizeof(GLuint), &frame.m_TextGlyphs[command.m_FirstCharacter], GL_DYNAMIC_DRAW);
 
 	// Draw the text
 	glBindVertexArray(m_ShaderTextBitmapFont_VAO);
@@ -720,14 +996,10 @@ void Engine::GraphicsManager::DrawText(const std::string& text, BitmapFont font,
 	glBindVertexArray(0);
 }
 
-// Draws a text message using the specified bitmap font
-void Engine::GraphicsManager::DrawTextAdvanced(const std::string& text, BitmapFont font, transform2D transform, float z, const colorRGBA& defaultColor)
+// Submits a recorded text message (supports color tags)
+void Engine::GraphicsManager::SubmitTextAdvanced(const TextCommand& command, const RenderFrame& frame)
 {
-	// Retrieve the bitmap font resource from the ResourceManager
-	BitmapFontResource& bitmapFontResource = ResourceManager::GetInstance().GetBitmapFontResource(font);
-
-	// Retrieve the sprite sheet resource from the ResourceManager
-	SpriteSheetResource& spriteSheetResource = ResourceManager::GetInstance().GetSpriteSheetResource(bitmapFontResource.m_SpriteSheet);
+	transform2D transform = command.m_Transform;
 
 	// Use the sprite sheet shader program
 	glUseProgram(m_ShaderTextBitmapFontAdvanced);
@@ -735,15 +1007,15 @@ void Engine::GraphicsManager::DrawTextAdvanced(const std::string& text, BitmapFo
 	// Bind the sprite sheet texture
 	glActiveTexture(GL_TEXTURE0);
 	glUniform1i(m_ShaderTextBitmapFontAdvanced_uSpriteSampler, 0);
-	glBindTexture(GL_TEXTURE_2D, ResourceManager::GetInstance().GetImageResource(spriteSheetResource.m_Image).GetTexture());
+	glBindTexture(GL_TEXTURE_2D, command.m_Texture);
 
 	// Pass the bitmap font data
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uGlyphSize, spriteSheetResource.m_Metadata.m_SpriteWidth, spriteSheetResource.m_Metadata.m_SpriteHeight);
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uGlyphOrigin, spriteSheetResource.m_Metadata.m_SpriteOriginX, spriteSheetResource.m_Metadata.m_SpriteOriginY);
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetGridSize, spriteSheetResource.m_Metadata.m_SheetColumns, spriteSheetResource.m_Metadata.m_SheetRows);
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetSize, spriteSheetResource.m_Metadata.m_SheetWidth, spriteSheetResource.m_Metadata.m_SheetHeight);
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetSeparation, spriteSheetResource.m_Metadata.m_SheetSeparationX, spriteSheetResource.m_Metadata.m_SheetSeparationY);
-	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetOrigin, spriteSheetResource.m_Metadata.m_SheetLeft, spriteSheetResource.m_Metadata.m_SheetTop);
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uGlyphSize, command.m_GlyphSize.x(), command.m_GlyphSize.y());
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uGlyphOrigin, command.m_GlyphOrigin.x(), command.m_GlyphOrigin.y());
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetGridSize, command.m_SheetGridSize.x(), command.m_SheetGridSize.y());
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetSize, command.m_SheetSize.x(), command.m_SheetSize.y());
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetSeparation, command.m_SheetSeparation.x(), command.m_SheetSeparation.y());
+	glUniform2i(m_ShaderTextBitmapFontAdvanced_uSpriteSheetOrigin, command.m_SheetOrigin.x(), command.m_SheetOrigin.y());
 
 	// TEMP HARDCODED
 	float m_TextAnimWaveXYOffset = 0.25f;
@@ -760,7 +1032,7 @@ void Engine::GraphicsManager::DrawTextAdvanced(const std::string& text, BitmapFo
 	// TEMP HARDCODED
 
 	// Pass the animation parameters
-	glUniform1f(m_ShaderTextBitmapFontAdvanced_uTimeSeconds, Engine::TimingManager::GetInstance().GetGameTime().GetTotalTimeSeconds());
+	glUniform1f(m_ShaderTextBitmapFontAdvanced_uTimeSeconds, frame.m_TimeSeconds);
 	glUniform1f(m_ShaderTextBitmapFontAdvanced_uAnimWaveXYOffset, m_TextAnimWaveXYOffset);
 	glUniform2f(m_ShaderTextBitmapFontAdvanced_uAnimWaveLength, m_TextAnimWaveLength.x(), m_TextAnimWaveLength.y());
 	glUniform2f(m_ShaderTextBitmapFontAdvanced_uAnimWaveFrequency, m_TextAnimWaveFrequency.x(), m_TextAnimWaveFrequency.y());
@@ -775,28 +1047,143 @@ void Engine::GraphicsManager::DrawTextAdvanced(const std::string& text, BitmapFo
 
 	// Calculate and pass the transformation matrices
 	glUniformMatrix4fv(m_ShaderTextBitmapFontAdvanced_uMatModel, 1, GL_FALSE, (GLfloat*)(&transform.GetTransformationMatrix()));
-	glUniformMatrix4fv(m_ShaderTextBitmapFontAdvanced_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-	glUniformMatrix4fv(m_ShaderTextBitmapFontAdvanced_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
-
-	// Calculate and pass the character data
-	std::vector<f2> characterPositions;
-	std::vector<unsigned int> glyphIndices;
-	std::vector<colorRGBA> glyphColors;
-	std::vector<BitmapFontResource::AnimationParameters> animParameters;
-	bitmapFontResource.GetCharacterDataAdvanced(text, characterPositions, glyphIndices, glyphColors, animParameters, defaultColor);
-	size_t numCharacters = characterPositions.size();
+	glUniformMatrix4fv(m_ShaderTextBitmapFontAdvanced_uMatView, 1, GL_FALSE, (GLfloat*)(&frame.m_ViewMatrix));
+	glUniformMatrix4fv(m_ShaderTextBitmapFontAdvanced_uMatProjection, 1, GL_FALSE, (GLfloat*)(&frame.m_ProjectionMatrix));
 
+	// Pass the character data (calculated when the text was recorded)
+	size_t numCharacters = command.m_NumCharacters;
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFontAdvanced_VBO_CharacterPosition);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(f2), &characterPositions[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(f2), &frame.m_TextPositions[command.m_FirstCharacter], GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFontAdvanced_VBO_GlyphIndex);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(unsigned int), &glyphIndices[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(unsigned int), &frame.m_TextGlyphs[command.m_FirstCharacter], GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFontAdvanced_VBO_GlyphColor);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(colorRGBA), &glyphColors[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(colorRGBA), &frame.m_TextColors[command.m_FirstStyle], GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, m_ShaderTextBitmapFontAdvanced_VBO_AnimationParameters);
-	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(BitmapFontResource::AnimationParameters), &animParameters[0], GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, numCharacters * sizeof(BitmapFontResource::AnimationParameters), &frame.m_TextAnimations[command.m_FirstStyle], GL_DYNAMIC_DRAW);
 
 	// Draw the text
 	glBindVertexArray(m_ShaderTextBitmapFontAdvanced_VAO);
 	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, numCharacters);
 	glBindVertexArray(0);
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////
+// Render thread                                              //
+////////////////////////////////////////////////////////////////
+
+// Enables or disables submitting draw commands on a dedicated render thread
+void Engine::GraphicsManager::SetRenderThread(bool enabled)
+{
+	if (enabled == m_RenderThreadEnabled) { return; }
+
+	if (enabled)
+	{
+		// Hand the OpenGL context over to the render thread
+		glfwMakeContextCurrent(NULL);
+		m_RenderThreadStopping = false;
+		m_RenderThreadEnabled = true;
+		m_RenderThread = std::thread(&GraphicsManager::RunRenderThread, this);
+	}
+	else
+	{
+		// Let the render thread finish the handed off frame and stop, and take the OpenGL context back
+		{
+			std::lock_guard<std::mutex> lock(m_RenderMutex);
+			m_RenderThreadStopping = true;
+			m_RenderCondition.notify_all();
+		}
+		m_RenderThread.join();
+		m_RenderThreadEnabled = false;
+		glfwMakeContextCurrent(m_Window);
+	}
+}
+
+// Runs a function that calls OpenGL on the thread that owns the OpenGL context (and waits for it to finish)
+void Engine::GraphicsManager::RunOnRenderThread(const std::function<void()>& function)
+{
+	if (!m_RenderThreadEnabled || std::this_thread::get_id() == m_RenderThread.get_id())
+	{
+		function();
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_RenderMutex);
+	m_RenderTasks.push_back(function);
+	size_t task = ++m_RenderTasksQueued;
+	m_RenderCondition.notify_all();
+	m_RenderCondition.wait(lock, [this, task]() { return m_RenderTasksRun >= task; });
+}
+
+// Runs a function that releases OpenGL objects (e.g. deletes a texture) once the draw commands recorded so far are submitted
+void Engine::GraphicsManager::ReleaseOnRenderThread(const std::function<void()>& function)
+{
+	m_RecordFrame->m_Releases.push_back(function);
+}
+
+// Hands off the recorded render frame for submission (on the render thread if enabled)
+void Engine::GraphicsManager::HandOffRenderFrame(bool swapBuffers)
+{
+	if (!swapBuffers && m_RecordFrame->m_Queue.empty()) { return; }
+
+	// Keep the camera and the time the frame is drawn with, as they change while the next frame is recorded
+	m_RecordFrame->m_ViewMatrix = GetCameraViewMatrix();
+	m_RecordFrame->m_ProjectionMatrix = GetCameraProjectionMatrix();
+	m_RecordFrame->m_TimeSeconds = (float)TimingManager::GetInstance().GetGameTime().GetTotalTimeSeconds();
+	m_RecordFrame->m_SwapBuffers = swapBuffers;
+
+	if (!m_RenderThreadEnabled)
+	{
+		SubmitRenderFrame(*m_RecordFrame);
+		return;
+	}
+
+	// Wait for the render thread to finish the previous frame, hand off the recorded frame, and record into the other one
+	std::unique_lock<std::mutex> lock(m_RenderMutex);
+	m_RenderCondition.wait(lock, [this]() { return m_SubmitFrame == NULL; });
+	m_SubmitFrame = m_RecordFrame;
+	m_RecordFrame = (m_RecordFrame == &m_RenderFrames[0]) ? &m_RenderFrames[1] : &m_RenderFrames[0];
+	m_RenderCondition.notify_all();
+}
+
+// Main function of the render thread
+void Engine::GraphicsManager::RunRenderThread()
+{
+	glfwMakeContextCurrent(m_Window);
+
+	std::unique_lock<std::mutex> lock(m_RenderMutex);
+	while (true)
+	{
+		m_RenderCondition.wait(lock, [this]() { return m_SubmitFrame != NULL || !m_RenderTasks.empty() || m_RenderThreadStopping; });
+
+		// Submit the handed off frame first, as the queued functions were called after it was recorded (and may change the textures it draws)
+		if (m_SubmitFrame != NULL)
+		{
+			RenderFrame* frame = m_SubmitFrame;
+			lock.unlock();
+			SubmitRenderFrame(*frame);
+			lock.lock();
+			m_SubmitFrame = NULL;
+			m_RenderCondition.notify_all();
+		}
+
+		// Run the queued functions (e.g. texture uploads for the frame that is being recorded)
+		while (!m_RenderTasks.empty())
+		{
+			std::function<void()> function = m_RenderTasks.front();
+			m_RenderTasks.pop_front();
+			lock.unlock();
+			function();
+			lock.lock();
+			m_RenderTasksRun++;
+			m_RenderCondition.notify_all();
+		}
+
+		// Finish whatever was handed off in the meantime before stopping
+		if (m_SubmitFrame != NULL || !m_RenderTasks.empty()) { continue; }
+
+		if (m_RenderThreadStopping) { break; }
+	}
+	lock.unlock();
+
+	glfwMakeContextCurrent(NULL);
+}
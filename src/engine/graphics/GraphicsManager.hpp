@@ -14,7 +14,14 @@
 #include "../common/utility/IntervalTypes.hpp" // For representing a rectangle
 #include "../common/utility/ShapeTypes.hpp" // For representing primitive shapes
 #include "../common/utility/ColorTypes.hpp" // For representing colors
+#include "RenderQueue.hpp" // For sorting draw commands before they are submitted
 #include <string> // For representing filenames and the window title
+#include <vector> // For recording the data of draw commands
+#include <deque> // For holding the functions queued on the render thread
+#include <functional> // For representing functions that run on the render thread
+#include <thread> // For running the render thread
+#include <mutex> // For guarding the hand-off to the render thread
+#include <condition_variable> // For waking up the render thread and the game thread
 
 namespace Engine{
 	class GraphicsManager : public Singleton<GraphicsManager>{
@@ -85,46 +92,28 @@ namespace Engine{
 
 		//////////////////////////////////////////////////// Line Shader
 		GLuint m_ShaderLine;
-		GLuint m_ShaderLine_uColor;
-		GLuint m_ShaderLine_uStart;
-		GLuint m_ShaderLine_uEnd;
 		GLuint m_ShaderLine_uMatView;
 		GLuint m_ShaderLine_uMatProjection;
 		GLuint m_ShaderLine_VAO;
 		GLuint m_ShaderLine_VBO;
 
-		/////////////////////////////////////////////// Rectangle Shader
-		GLuint m_ShaderRectangle;
-		GLuint m_ShaderRectangle_uColor;
-		GLuint m_ShaderRectangle_uBottomLeft;
-		GLuint m_ShaderRectangle_uTopRight;
-		GLuint m_ShaderRectangle_uMatView;
-		GLuint m_ShaderRectangle_uMatProjection;
-		GLuint m_ShaderRectangle_VAO;
-		GLuint m_ShaderRectangle_VBO;
-
 		////////////////////////////////////////////////// Circle Shader
 		GLuint m_ShaderCircle;
-		GLuint m_ShaderCircle_uColor;
-		GLuint m_ShaderCircle_uPosition;
-		GLuint m_ShaderCircle_uRadius;
 		GLuint m_ShaderCircle_uMatView;
 		GLuint m_ShaderCircle_uMatProjection;
 		GLuint m_ShaderCircle_VAO;
 		GLuint m_ShaderCircle_VBO;
+		GLuint m_ShaderCircle_VBO_Instances;
 
 		//////////////////////////////////////////// Sprite Sheet Shader
 		GLuint m_ShaderSpriteSheet;
-		GLuint m_ShaderSpriteSheet_uTransparancyColor;
-		GLuint m_ShaderSpriteSheet_uPosBottomLeft;
-		GLuint m_ShaderSpriteSheet_uPosTopRight;
-		GLuint m_ShaderSpriteSheet_uUVBottomLeft;
-		GLuint m_ShaderSpriteSheet_uUVTopRight;
-		GLuint m_ShaderSpriteSheet_uMatModel;
+		GLuint m_ShaderSpriteSheet_uDepthStep;
 		GLuint m_ShaderSpriteSheet_uMatView;
 		GLuint m_ShaderSpriteSheet_uMatProjection;
+		GLuint m_ShaderSpriteSheet_uSpriteSampler;
 		GLuint m_ShaderSpriteSheet_VAO;
 		GLuint m_ShaderSpriteSheet_VBO;
+		GLuint m_ShaderSpriteSheet_VBO_Instances;
 
 		//////////////////////////////////////// Bitmap Font Text Shader
 		GLuint m_ShaderTextBitmapFont;
@@ -217,6 +206,9 @@ namespace Engine{
 		// Gets the camera zoom
 		float GetCameraZoom();
 
+		// Gets the area of the world that is visible through the camera
+		aabb2Df GetCameraView();
+
 		// Gets the camera's view matrix
 		const mat4f& GetCameraViewMatrix();
 
@@ -225,115 +217,204 @@ namespace Engine{
 
 	public:
 
+		////////////////////////////////////////////////////////////////
+		// Render queue                                               //
+		////////////////////////////////////////////////////////////////
+
+	private:
+
+		// Draw commands and their data, as recorded by the game thread for a frame
+		struct RenderFrame;
+
+		// Layer of the draw commands that are recorded
+		unsigned char m_RenderLayer;
+
+		// Statistics of the frame that is being submitted, and of the last frame that was submitted (guarded by the render mutex)
+		RenderStatistics m_FrameStatistics;
+		RenderStatistics m_RenderStatistics;
+
+		// Makes room for a draw command (flushes the render queue when it is full)
+		inline void ReserveRenderCommand() { if (m_RecordFrame->m_Queue.full()) { FlushRenderQueue(); } }
+
+		// Records a draw command in the render queue
+		inline void RecordRenderCommand(RenderQueue::Program program, float z, unsigned int texture, size_t first, size_t count)
+		{
+			m_RecordFrame->m_Queue.Record(m_RenderLayer, (z - m_ZNear) / (m_ZFar - m_ZNear), program, texture, (unsigned int)first, (unsigned int)count);
+		}
+
+		// Sorts and submits the draw commands of a render frame (on the thread that owns the OpenGL context)
+		void SubmitRenderFrame(RenderFrame& frame);
+
+		// Uses a shader program for drawing from the render queue, and passes the transformation matrices of the render frame
+		void UseRenderProgram(RenderQueue::Program program, const RenderFrame& frame);
+
+	public:
+
+		// Topmost render layer (drawn over all other layers, e.g. for debug drawing)
+		static const unsigned char s_TopRenderLayer = 255;
+
+		// Sets the layer of the draw commands that are recorded
+		//		NOTE: drawing is recorded into the render queue, and drawn when
+		//		the queue is flushed (at the latest when the buffers are swapped).
+		//		The queue draws layer by layer, and by increasing z within each
+		//		layer. At the same layer and z, sprites are drawn first, then text,
+		//		then lines and circles. Sprites keep the order they were drawn in
+		//		among each other, but are grouped by sprite sheet texture.
+		inline void SetRenderLayer(unsigned char layer) { m_RenderLayer = layer; }
+
+		// Gets the layer of the draw commands that are recorded
+		inline unsigned char GetRenderLayer() const { return m_RenderLayer; }
+
+		// Sorts and draws all recorded draw commands (drawing recorded afterwards ends up on top)
+		void FlushRenderQueue();
+
+		// Gets the numbers of draw calls and state changes of the last frame, before and after sorting
+		RenderStatistics GetRenderStatistics();
+
 		////////////////////////////////////////////////////////////////
 		// Primitive drawing                                          //
 		////////////////////////////////////////////////////////////////
 
-		////////////////////////////////////////////////////////// Lines
+	private:
 
-		// Draws a line
-		template<typename valuetype>
-		void DrawLine(const ray2D<valuetype>& line, const colorRGBA& color = colorRGBA())
+		// Vertex of a recorded line (laid out as the vertex attributes of the line shader)
+		struct LineVertex
 		{
-			// Use the sprite sheet shader program
-			glUseProgram(m_ShaderLine);
+			GLfloat m_Position[2];
+			GLfloat m_Color[4];
+		};
 
-			// Pass the start- and endpoints of the line
-			glUniform2f(m_ShaderLine_uStart, line.x1(), line.y1());
-			glUniform2f(m_ShaderLine_uEnd, line.x2(), line.y2());
+		// Recorded circle (laid out as the instance attributes of the circle shader)
+		struct CircleInstance
+		{
+			GLfloat m_Position[2];
+			GLfloat m_Radius;
+			GLfloat m_Color[4];
+		};
 
-			// Pass the color of the line
-			glUniform4f(m_ShaderLine_uColor, color.r(), color.g(), color.b(), color.a());
+		// Recorded lines and circles in the sorted order of the render queue (reused between flushes)
+		std::vector<LineVertex> m_LineUpload;
+		std::vector<CircleInstance> m_CircleUpload;
 
-			// Pass the transformation matrices
-			glUniformMatrix4fv(m_ShaderLine_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-			glUniformMatrix4fv(m_ShaderLine_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
+		// Number of line vertices and circles the streaming buffers can hold
+		size_t m_LineCapacity;
+		size_t m_CircleCapacity;
 
-			// Draw the line
-			glBindVertexArray(m_ShaderLine_VAO);
-			glDrawArrays(GL_LINES, 0, 2);
-			glBindVertexArray(0);
+		// Appends a line to the recorded line vertices
+		inline void QueueLine(float x1, float y1, float x2, float y2, const colorRGBA& color)
+		{
+			LineVertex start = { { x1, y1 }, { color.r(), color.g(), color.b(), color.a() } };
+			LineVertex end = { { x2, y2 }, { color.r(), color.g(), color.b(), color.a() } };
+			m_RecordFrame->m_LineVertices.push_back(start);
+			m_RecordFrame->m_LineVertices.push_back(end);
+		}
+
+	public:
+
+		////////////////////////////////////////////////////////// Lines
+
+		// Draws a line (at the specified z within the current render layer)
+		template<typename valuetype>
+		void DrawLine(const ray2D<valuetype>& line, const colorRGBA& color = colorRGBA(), float z = 0.0f)
+		{
+			ReserveRenderCommand();
+			RecordRenderCommand(RenderQueue::Program::LINE, z, 0, m_RecordFrame->m_LineVertices.size(), 2);
+			QueueLine((float)line.x1(), (float)line.y1(), (float)line.x2(), (float)line.y2(), color);
 		}
 
 		// Draws a line
 		template<typename valuetype>
-		inline void DrawLine(const vector2D<valuetype>& p1, const vector2D<valuetype>& p2, const colorRGBA& color = colorRGBA()) { DrawLine(ray2D<valuetype>(p1, p2), color); }
+		inline void DrawLine(const vector2D<valuetype>& p1, const vector2D<valuetype>& p2, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawLine(ray2D<valuetype>(p1, p2), color, z); }
 
 		// Draws a line
 		template<typename valuetype>
-		inline void DrawLine(valuetype x1, valuetype x2, valuetype y1, valuetype y2, const colorRGBA& color = colorRGBA()) { DrawLine(ray2D<valuetype>(x1, x2, y1, y2), color); }
+		inline void DrawLine(valuetype x1, valuetype x2, valuetype y1, valuetype y2, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawLine(ray2D<valuetype>(x1, x2, y1, y2), color, z); }
 
 		///////////////////////////////////////////////////// Rectangles
 
-		// Draws a rectangle
+		// Draws a rectangle (at the specified z within the current render layer)
 		template<typename valuetype>
-		void DrawRectangle(const interval2D<valuetype>& rectangle, const colorRGBA& color = colorRGBA())
+		void DrawRectangle(const interval2D<valuetype>& rectangle, const colorRGBA& color = colorRGBA(), float z = 0.0f)
 		{
-			// Use the sprite sheet shader program
-			glUseProgram(m_ShaderRectangle);
-
-			// Pass the start- and endpoints of the line
-			glUniform2f(m_ShaderRectangle_uBottomLeft, rectangle.x1(), rectangle.y1());
-			glUniform2f(m_ShaderRectangle_uTopRight, rectangle.x2(), rectangle.y2());
-
-			// Pass the color of the line
-			glUniform4f(m_ShaderRectangle_uColor, color.r(), color.g(), color.b(), color.a());
-
-			// Pass the transformation matrices
-			glUniformMatrix4fv(m_ShaderRectangle_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-			glUniformMatrix4fv(m_ShaderRectangle_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
-
-			// Draw the line
-			glBindVertexArray(m_ShaderRectangle_VAO);
-			glDrawArrays(GL_LINE_LOOP, 0, 4);
-			glBindVertexArray(0);
+			ReserveRenderCommand();
+			RecordRenderCommand(RenderQueue::Program::LINE, z, 0, m_RecordFrame->m_LineVertices.size(), 8);
+
+			// Queue the sides of the rectangle
+			float x1 = (float)rectangle.x1(), y1 = (float)rectangle.y1(), x2 = (float)rectangle.x2(), y2 = (float)rectangle.y2();
+			QueueLine(x1, y1, x2, y1, color);
+			QueueLine(x2, y1, x2, y2, color);
+			QueueLine(x2, y2, x1, y2, color);
+			QueueLine(x1, y2, x1, y1, color);
 		}
 
 		// Draws a rectangle
 		template<typename valuetype>
-		inline void DrawRectangle(const vector2D<valuetype>& p1, const vector2D<valuetype>& p2, const colorRGBA& color = colorRGBA()) { DrawRectangle(interval2D<valuetype>(p1, p2), color); }
+		inline void DrawRectangle(const vector2D<valuetype>& p1, const vector2D<valuetype>& p2, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawRectangle(interval2D<valuetype>(p1, p2), color, z); }
 
 		// Draws a rectangle
 		template<typename valuetype>
-		inline void DrawRectangle(valuetype x1, valuetype x2, valuetype y1, valuetype y2, const colorRGBA& color = colorRGBA()) { DrawRectangle(interval2D<valuetype>(x1, x2, y1, y2), color); }
+		inline void DrawRectangle(valuetype x1, valuetype x2, valuetype y1, valuetype y2, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawRectangle(interval2D<valuetype>(x1, x2, y1, y2), color, z); }
 
 		//////////////////////////////////////////////////////// Circles
 
+		// Draws a circle (at the specified z within the current render layer)
 		template<typename valuetype>
-		void DrawCircle(const circle<valuetype>& circle, const colorRGBA& color = colorRGBA())
+		void DrawCircle(const circle<valuetype>& circle, const colorRGBA& color = colorRGBA(), float z = 0.0f)
 		{
-			// Use the sprite sheet shader program
-			glUseProgram(m_ShaderCircle);
-
-			// Pass the start- and endpoints of the line
-			glUniform2f(m_ShaderCircle_uPosition, circle.x(), circle.y());
-			glUniform1f(m_ShaderCircle_uRadius, circle.r());
+			ReserveRenderCommand();
+			RecordRenderCommand(RenderQueue::Program::CIRCLE, z, 0, m_RecordFrame->m_CircleInstances.size(), 1);
 
-			// Pass the color of the line
-			glUniform4f(m_ShaderCircle_uColor, color.r(), color.g(), color.b(), color.a());
-
-			// Pass the transformation matrices
-			glUniformMatrix4fv(m_ShaderCircle_uMatView, 1, GL_FALSE, (GLfloat*)(&GetCameraViewMatrix()));
-			glUniformMatrix4fv(m_ShaderCircle_uMatProjection, 1, GL_FALSE, (GLfloat*)(&GetCameraProjectionMatrix()));
-
-			// Draw the line
-			glBindVertexArray(m_ShaderCircle_VAO);
-			glDrawArrays(GL_LINE_LOOP, 0, s_NumCircleSegments);
-			glBindVertexArray(0);
+			CircleInstance instance = { { (float)circle.x(), (float)circle.y() }, (float)circle.r(), { color.r(), color.g(), color.b(), color.a() } };
+			m_RecordFrame->m_CircleInstances.push_back(instance);
 		}
 
 		// Draws a circle
 		template<typename valuetype>
-		inline void DrawCircle(const vector2D<valuetype>& p, valuetype r, const colorRGBA& color = colorRGBA()) { DrawCircle(circle<valuetype>(p, r), color); }
+		inline void DrawCircle(const vector2D<valuetype>& p, valuetype r, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawCircle(circle<valuetype>(p, r), color, z); }
 
 		// Draws a circle
 		template<typename valuetype>
-		inline void DrawCircle(valuetype x, valuetype y, valuetype r, const colorRGBA& color = colorRGBA()) { DrawCircle(circle<valuetype>(x, y, r), color); }
+		inline void DrawCircle(valuetype x, valuetype y, valuetype r, const colorRGBA& color = colorRGBA(), float z = 0.0f) { DrawCircle(circle<valuetype>(x, y, r), color, z); }
 
 		////////////////////////////////////////////////////////////////
 		// Sprite sheet drawing                                       //
 		////////////////////////////////////////////////////////////////
 
+	private:
+
+		// Per-sprite data of a recorded sprite sheet frame (laid out as the instance attributes of the sprite sheet shader)
+		struct SpriteInstance
+		{
+			GLfloat m_Positions[4]; // Local bottom-left and top-right corners
+			GLfloat m_UVs[4]; // Bottom-left and top-right UVs of the frame
+			GLfloat m_Translation[3];
+			GLfloat m_Rotation;
+			GLfloat m_Scale[2];
+			GLfloat m_Order; // Position of the sprite in the draw order of the frame (set when flushed)
+			GLfloat m_Padding;
+			GLfloat m_TransparancyColor[4];
+		};
+
+		// Recorded sprites in the sorted order of the render queue, and the sequence numbers of the sprites at a layer and z (reused between flushes)
+		std::vector<SpriteInstance> m_SpriteUpload;
+		std::vector<std::pair<unsigned int, size_t>> m_SpriteSequences;
+
+		// Number of sprites the instance buffer can hold
+		size_t m_SpriteCapacity;
+
+		// Number of sprites drawn since the depth buffer was cleared
+		size_t m_SpriteDepth;
+
+		// Maximum number of sprites drawn before the depth buffer is cleared
+		//		NOTE: sprites at the same layer and z are drawn per texture, and
+		//		keep their draw order through the depth test, with every sprite
+		//		slightly closer than the sprites drawn before it. As frames
+		//		either are opaque or are discarded, this draws the same as drawing
+		//		them one by one.
+		static const size_t s_MaxSpriteDepth = 1 << 22;
+
+	public:
+
 		// Draws a frame of the specified sprite sheet
 		void DrawSpriteSheetFrame(SpriteSheet spriteSheet, unsigned int frame, const f3& translation, float rotation = 0.0f, const f2& scale = f2(1.0f, 1.0f));
 
@@ -347,12 +428,124 @@ namespace Engine{
 		// Text drawing												  //
 		////////////////////////////////////////////////////////////////
 
+	private:
+
+		// Recorded text message (copies the layout of its bitmap font, so the font can be unloaded before the text is submitted)
+		struct TextCommand
+		{
+			GLuint m_Texture;
+			i2 m_GlyphSize;
+			i2 m_GlyphOrigin;
+			i2 m_SheetGridSize;
+			i2 m_SheetSeparation;
+			i2 m_SheetOrigin; // Top-left position of the sheet layout in the texture
+			i2 m_SheetSize; // Size of the texture
+			transform2D m_Transform;
+			colorRGBA m_Color;
+			size_t m_FirstCharacter; // First character in the character data of the render frame
+			size_t m_NumCharacters;
+			size_t m_FirstStyle; // First character in the colors and animation parameters of the render frame (for text with color tags)
+		};
+
+		// Records a text message
+		void RecordText(RenderQueue::Program program, const std::string& text, BitmapFont font, const transform2D& transform, float z, const colorRGBA& color);
+
+		// Submits a recorded text message
+		void SubmitText(const TextCommand& command, const RenderFrame& frame);
+
+		// Submits a recorded text message (supports color tags)
+		void SubmitTextAdvanced(const TextCommand& command, const RenderFrame& frame);
+
+	public:
+
 		// Draws a text message using the specified bitmap font
 		void DrawText(const std::string& text, BitmapFont font, transform2D transform, float z = 0.0f, const colorRGBA& color = colorRGBA());
 
 		// Draws a text message using the specified bitmap font (supports color tags)
 		void DrawTextAdvanced(const std::string& text, BitmapFont font, transform2D transform, float z = 0.0f, const colorRGBA& defaultColor = colorRGBA());
 
+		////////////////////////////////////////////////////////////////
+		// Render thread                                              //
+		////////////////////////////////////////////////////////////////
+
+	private:
+
+		// Draw commands and their data, as recorded by the game thread for a frame
+		struct RenderFrame
+		{
+			RenderQueue m_Queue;
+			std::vector<LineVertex> m_LineVertices; // Two vertices per line
+			std::vector<CircleInstance> m_CircleInstances;
+			std::vector<SpriteInstance> m_SpriteInstances;
+			std::vector<GLuint> m_SpriteTextures; // Sprite sheet texture of each sprite
+			std::vector<TextCommand> m_TextCommands;
+			std::vector<f2> m_TextPositions; // Position of each character of the text messages
+			std::vector<unsigned int> m_TextGlyphs; // Glyph of each character of the text messages
+			std::vector<colorRGBA> m_TextColors; // Color of each character of the text messages with color tags
+			std::vector<BitmapFontResource::AnimationParameters> m_TextAnimations; // Animation of each character of the text messages with color tags
+			std::vector<std::function<void()>> m_Releases; // Functions that release OpenGL objects once the frame is submitted
+			mat4f m_ViewMatrix; // Camera matrices when the frame was handed off
+			mat4f m_ProjectionMatrix;
+			float m_TimeSeconds; // Game time when the frame was handed off (for animating text)
+			bool m_SwapBuffers; // Whether the frame ends with swapping the buffers (or is flushed halfway)
+		};
+
+		// Render frames (one recorded by the game thread, and one submitted by the render thread)
+		RenderFrame m_RenderFrames[2];
+
+		// Render frame that is being recorded
+		RenderFrame* m_RecordFrame;
+
+		// Render frame that is handed off to the render thread, or NULL when the render thread is idle
+		RenderFrame* m_SubmitFrame;
+
+		// Whether or not the OpenGL context is owned by the render thread
+		bool m_RenderThreadEnabled;
+
+		// Whether or not the render thread should stop
+		bool m_RenderThreadStopping;
+
+		// Thread owning the OpenGL context (if enabled)
+		std::thread m_RenderThread;
+
+		// Functions queued to run on the render thread, and the numbers of functions queued and run so far
+		std::deque<std::function<void()>> m_RenderTasks;
+		size_t m_RenderTasksQueued;
+		size_t m_RenderTasksRun;
+
+		// Guards the hand-off of render frames and functions to the render thread
+		std::mutex m_RenderMutex;
+		std::condition_variable m_RenderCondition;
+
+		// Hands off the recorded render frame for submission (on the render thread if enabled)
+		void HandOffRenderFrame(bool swapBuffers);
+
+		// Main function of the render thread
+		void RunRenderThread();
+
+	public:
+
+		// Enables or disables submitting draw commands on a dedicated render thread
+		//		NOTE: when enabled, the render thread owns the OpenGL context, and
+		//		submits the draw commands of a frame while the game thread updates
+		//		and records the next frame. Swapping the buffers only waits for the
+		//		render thread to finish the previous frame. When disabled, draw
+		//		commands are submitted by the game thread (e.g. for debugging).
+		void SetRenderThread(bool enabled);
+
+		// Checks whether draw commands are submitted on a dedicated render thread
+		inline bool IsRenderThreadEnabled() const { return m_RenderThreadEnabled; }
+
+		// Runs a function that calls OpenGL on the thread that owns the OpenGL context (and waits for it to finish)
+		void RunOnRenderThread(const std::function<void()>& function);
+
+		// Runs a function that releases OpenGL objects (e.g. deletes a texture) once the draw commands recorded so far are submitted
+		//		NOTE: draw commands only refer to textures by name, so textures
+		//		are deleted after the frames that may still draw them. The 
+		//		function is run on the thread that owns the OpenGL context, and
+		//		should not refer to objects that can be destroyed in the meantime.
+		void ReleaseOnRenderThread(const std::function<void()>& function);
+
 		friend class InputManager;
 
 	};
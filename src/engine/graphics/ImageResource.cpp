@@ -2,6 +2,7 @@
 
 #include "..\debugging\LoggingManager.hpp" // For reporting errors
 #include "..\common\utility\PathConfig.hpp" // For retrieving the image path
+#include "GraphicsManager.hpp" // For calling OpenGL on the thread that owns the OpenGL context
 
 ////////////////////////////////////////////////////////////////
 // Construction, loading and unloading                        //
@@ -38,7 +39,7 @@ bool Engine::ImageResource::Load()
 	ConvertImageFormat();
 	
 	// Generate an OpenGL texture and upload the image to the GPU
-	glGenTextures(1, &m_TextureID);
+	GraphicsManager::GetInstance().RunOnRenderThread([this]() { glGenTextures(1, &m_TextureID); });
 	UploadTexture();
 	
 	return true;
@@ -47,8 +48,9 @@ bool Engine::ImageResource::Load()
 // Unloads the image
 bool Engine::ImageResource::Unload()
 {
-	// Delete the OpenGL texture storing the image
-	glDeleteTextures(1, &m_TextureID);
+	// Delete the OpenGL texture storing the image (once the frames that may still draw it are submitted)
+	GLuint texture = m_TextureID;
+	GraphicsManager::GetInstance().ReleaseOnRenderThread([texture]() { glDeleteTextures(1, &texture); });
 
 	// Unload the FreeImage image from memory
 	FreeImage_Unload(m_Image);
@@ -114,35 +116,39 @@ GLuint Engine::ImageResource::GetTexture()
 // Uploads the texture to the GPU (called automatically, but can be explicitely called to force an upload at a desired point in time)
 void Engine::ImageResource::UploadTexture()
 {
-	// Get the image bit-data and metadata
-	void* imageData = (void*)FreeImage_GetBits(m_Image);
-	i2 dim = GetDimensions();
-
-	// Bind the texture buffer and set sampling parameters
-	glBindTexture(GL_TEXTURE_2D, m_TextureID);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-	// Determine the texture buffer format based on the image format and upoad the data to the GPU
-	switch (m_ImageFormat)
+	// Upload on the thread that owns the OpenGL context (the render thread, if enabled)
+	GraphicsManager::GetInstance().RunOnRenderThread([this]()
 	{
-	case ImageFormat::MONOCHROME: 
-		if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_RED, GL_UNSIGNED_BYTE, imageData); }
-		if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, dim.x(), dim.y(), 0, GL_RED, GL_UNSIGNED_BYTE, imageData); }
-		break;
-	case ImageFormat::GRAYSCALE: 
-		if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_RED, GL_UNSIGNED_BYTE, imageData); }
-		if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, dim.x(), dim.y(), 0, GL_RED, GL_UNSIGNED_BYTE, imageData); }
-		break;
-	case ImageFormat::RGB: 
-		if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_BGR, GL_UNSIGNED_BYTE, imageData); }
-		if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, dim.x(), dim.y(), 0, GL_BGR, GL_UNSIGNED_BYTE, imageData); }
-		break;
-	case ImageFormat::RGBA: 
-		if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_BGRA, GL_UNSIGNED_BYTE, imageData); }
-		if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, dim.x(), dim.y(), 0, GL_BGRA, GL_UNSIGNED_BYTE, imageData); }
-		break;
-	}
+		// Get the image bit-data and metadata
+		void* imageData = (void*)FreeImage_GetBits(m_Image);
+		i2 dim = GetDimensions();
+
+		// Bind the texture buffer and set sampling parameters
+		glBindTexture(GL_TEXTURE_2D, m_TextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+		// Determine the texture buffer format based on the image format and upoad the data to the GPU
+		switch (m_ImageFormat)
+		{
+		case ImageFormat::MONOCHROME: 
+			if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_RED, GL_UNSIGNED_BYTE, imageData); }
+			if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, dim.x(), dim.y(), 0, GL_RED, GL_UNSIGNED_BYTE, imageData); }
+			break;
+		case ImageFormat::GRAYSCALE: 
+			if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_RED, GL_UNSIGNED_BYTE, imageData); }
+			if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, dim.x(), dim.y(), 0, GL_RED, GL_UNSIGNED_BYTE, imageData); }
+			break;
+		case ImageFormat::RGB: 
+			if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_BGR, GL_UNSIGNED_BYTE, imageData); }
+			if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, dim.x(), dim.y(), 0, GL_BGR, GL_UNSIGNED_BYTE, imageData); }
+			break;
+		case ImageFormat::RGBA: 
+			if (m_Dirty == DirtyType::DIRTY_VALUES) { glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dim.x(), dim.y(), GL_BGRA, GL_UNSIGNED_BYTE, imageData); }
+			if (m_Dirty == DirtyType::DIRTY_SIZE_AND_VALUES) { glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, dim.x(), dim.y(), 0, GL_BGRA, GL_UNSIGNED_BYTE, imageData); }
+			break;
+		}
+	});
 
 	// Reset the dirty flag
 	m_Dirty = DirtyType::CLEAN;
@@ -178,6 +178,8 @@ namespace Engine
 
 		friend class ResourceManager;
 		friend class GraphicsManager;
+		friend class SpriteSheetResource;
+		friend class TextureAtlas;
 
 	};
 }
@@ -0,0 +1,66 @@
+#include "RenderQueue.hpp"
+
+// Records a draw command (z is normalized to the range [0, 1])
+void Engine::RenderQueue::Record(unsigned char layer, float z, Program program, unsigned int texture, unsigned int first, unsigned int count)
+{
+	if (z < 0.0f) { z = 0.0f; }
+	if (z > 1.0f) { z = 1.0f; }
+
+	RenderCommand command;
+	command.m_Key =
+		((RenderKey)layer << 56) |
+		((RenderKey)(z * 65535.0f) << 40) |
+		((RenderKey)program << 36) |
+		((RenderKey)(texture & 0xFFFF) << 20) |
+		(RenderKey)(m_Commands.size() & 0xFFFFF);
+	command.m_First = first;
+	command.m_Count = count;
+	m_Commands.push_back(command);
+}
+
+// Sorts the draw commands by key (radix sort)
+void Engine::RenderQueue::Sort()
+{
+	size_t numCommands = m_Commands.size();
+	if (numCommands < 2) { return; }
+	m_Sorted.resize(numCommands);
+
+	// Sort by one byte of the key at a time, from the least to the most significant byte
+	for (unsigned int shift = 0; shift < 64; shift += 8)
+	{
+		size_t counts[256] = { 0 };
+		for (size_t i = 0; i < numCommands; i++) { counts[(m_Commands[i].m_Key >> shift) & 0xFF]++; }
+
+		// Skip the byte if all keys share it (e.g. the layer, in a frame without layers)
+		if (counts[(m_Commands[0].m_Key >> shift) & 0xFF] == numCommands) { continue; }
+
+		size_t offset = 0;
+		for (size_t digit = 0; digit < 256; digit++)
+		{
+			size_t count = counts[digit];
+			counts[digit] = offset;
+			offset += count;
+		}
+		for (size_t i = 0; i < numCommands; i++) { m_Sorted[counts[(m_Commands[i].m_Key >> shift) & 0xFF]++] = m_Commands[i]; }
+		m_Commands.swap(m_Sorted);
+	}
+}
+
+// Counts the draw calls and state changes to submit the draw commands in their current order
+void Engine::RenderQueue::CountDrawCalls(size_t& drawCalls, size_t& stateChanges) const
+{
+	drawCalls = 0;
+	stateChanges = 0;
+	for (size_t i = 0; i < m_Commands.size(); i++)
+	{
+		RenderKey key = m_Commands[i].m_Key;
+		if (i > 0 && IsBatched(m_Commands[i - 1].m_Key, key)) { continue; }
+		drawCalls++;
+
+		// Count the program and texture switches from the previous draw call
+		if (i == 0) { stateChanges += IsTextured(GetProgram(key)) ? 2 : 1; continue; }
+		RenderKey previous = m_Commands[i - 1].m_Key;
+		if (GetProgram(previous) != GetProgram(key)) { stateChanges++; }
+		if (IsTextured(GetProgram(key)) && GetTexture(previous) != GetTexture(key)) { stateChanges++; }
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef ENGINE_GRAPHICS_RENDERQUEUE_H
+#define ENGINE_GRAPHICS_RENDERQUEUE_H
+
+#include <vector> // For holding the draw commands
+#include <cstddef> // For size_t
+
+namespace Engine{
+
+	// Sort key of a draw command
+	//		NOTE: from the most to the least significant bits, the key holds
+	//		the layer (8 bits), z (16 bits), program (4 bits), texture (16 bits)
+	//		and the sequence number of the command within the frame (20 bits),
+	//		so sorting the keys groups draws with the same program and texture
+	//		within every layer and z, and keeps the order they were recorded in
+	//		otherwise.
+	typedef unsigned long long RenderKey;
+
+	// Draw command recorded in the render queue
+	struct RenderCommand
+	{
+		RenderKey m_Key;
+		unsigned int m_First; // First payload entry of the command (e.g. sprite or line vertex)
+		unsigned int m_Count; // Number of payload entries of the command
+	};
+
+	// Numbers of draw calls and state changes (program and texture switches) of the render queue
+	struct RenderStatistics
+	{
+		size_t m_Commands = 0;
+		size_t m_DrawCallsUnsorted = 0; // Draw calls had the commands been submitted in the order they were recorded in
+		size_t m_StateChangesUnsorted = 0; // State changes had the commands been submitted in the order they were recorded in
+		size_t m_DrawCalls = 0;
+		size_t m_StateChanges = 0;
+	};
+
+	// Queue of draw commands that are sorted by key before they are submitted
+	//		NOTE: consecutive commands with the same program and texture are
+	//		submitted as one draw call (except text, which is drawn per
+	//		command), so sorting mostly cuts the number of draw calls and the
+	//		number of program and texture switches in between.
+	class RenderQueue
+	{
+
+	public:
+
+		// Programs of draw commands (in the order they are drawn in within a layer and z)
+		enum class Program : unsigned char
+		{
+			SPRITE_SHEET,
+			TEXT_BITMAP_FONT,
+			TEXT_BITMAP_FONT_ADVANCED,
+			LINE,
+			CIRCLE
+		};
+
+		// Maximum number of commands in the queue (the number of sequence numbers)
+		static const size_t s_MaxCommands = 1 << 20;
+
+		// Constructor
+		RenderQueue() { }
+
+		// Records a draw command (z is normalized to the range [0, 1])
+		void Record(unsigned char layer, float z, Program program, unsigned int texture, unsigned int first, unsigned int count);
+
+		// Sorts the draw commands by key (radix sort)
+		void Sort();
+
+		// Removes all draw commands
+		inline void Clear() { m_Commands.clear(); }
+
+		// Counts the draw calls and state changes to submit the draw commands in their current order
+		void CountDrawCalls(size_t& drawCalls, size_t& stateChanges) const;
+
+		// Gets the number of draw commands
+		inline size_t size() const { return m_Commands.size(); }
+
+		// Checks whether the queue holds no draw commands
+		inline bool empty() const { return m_Commands.empty(); }
+
+		// Checks whether the queue holds the maximum number of draw commands
+		inline bool full() const { return m_Commands.size() >= s_MaxCommands; }
+
+		// Gets a draw command
+		inline const RenderCommand& operator[](size_t i) const { return m_Commands[i]; }
+
+		// Gets the layer and z of a key
+		static inline unsigned int LayerAndZ(RenderKey key) { return (unsigned int)(key >> 40); }
+
+		// Gets the program of a key
+		static inline Program GetProgram(RenderKey key) { return (Program)((key >> 36) & 0xF); }
+
+		// Gets the texture of a key (the lowest 16 bits of the texture name)
+		static inline unsigned int GetTexture(RenderKey key) { return (unsigned int)((key >> 20) & 0xFFFF); }
+
+		// Gets the sequence number of a key
+		static inline unsigned int GetSequence(RenderKey key) { return (unsigned int)(key & 0xFFFFF); }
+
+		// Checks whether a program draws from a texture
+		static inline bool IsTextured(Program program) { return program != Program::LINE && program != Program::CIRCLE; }
+
+		// Checks whether two consecutive draw commands are submitted as one draw call
+		static inline bool IsBatched(RenderKey a, RenderKey b)
+		{
+			Program program = GetProgram(a);
+			if (program == Program::TEXT_BITMAP_FONT || program == Program::TEXT_BITMAP_FONT_ADVANCED) { return false; }
+			return program == GetProgram(b) && GetTexture(a) == GetTexture(b);
+		}
+
+	private:
+
+		// Draw commands, and scratch space for sorting them
+		std::vector<RenderCommand> m_Commands;
+		std::vector<RenderCommand> m_Sorted;
+
+	};
+}
+
+#endif
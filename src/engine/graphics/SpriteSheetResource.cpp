@@ -7,6 +7,7 @@
 // Constructor, stores the filename of the sprite sheet
 Engine::SpriteSheetResource::SpriteSheetResource(const std::string& filename)
 	: m_Filename(filename)
+	, m_PackedInAtlas(false)
 {
 	
 }
@@ -22,6 +23,9 @@ bool Engine::SpriteSheetResource::Load()
 	// Load the associated image
 	m_Image = ResourceManager::GetInstance().ReserveImage(m_FilenameImage);
 
+	// Pack the image in the texture atlas (unless the sprite sheet opts out)
+	if (m_Metadata.m_PackInAtlas) { m_PackedInAtlas = ResourceManager::GetInstance().GetTextureAtlas().Add(m_Image, ResourceManager::GetInstance().GetImageResource(m_Image), m_AtlasRegion); }
+
 	return true;
 }
 
@@ -29,6 +33,7 @@ bool Engine::SpriteSheetResource::Load()
 bool Engine::SpriteSheetResource::Unload()
 {
 	// Unload the image associated to the sprite sheet
+	if (m_PackedInAtlas) { ResourceManager::GetInstance().GetTextureAtlas().Remove(m_Image); }
 	ResourceManager::GetInstance().FreeImage(m_Image);
 
 	return true;
@@ -38,20 +43,37 @@ bool Engine::SpriteSheetResource::Unload()
 // Metadata manipulation									  //
 ////////////////////////////////////////////////////////////////
 
-// Calculates the bottom-left and top-right UVs based on the frame number
-void Engine::SpriteSheetResource::CalculateUVs(unsigned int frame, f2& out_UV1, f2& out_UV2) const
+// Gets the texture the sprite sheet is drawn from (the page of the texture atlas it is packed in, or its own image), and the top-left position of the sheet layout and the size of that texture in pixels
+GLuint Engine::SpriteSheetResource::GetTexture(i2& out_Origin, i2& out_Size)
+{
+	ImageResource& imageResource = ResourceManager::GetInstance().GetImageResource(m_Image);
+	GLuint texture;
+	if (m_PackedInAtlas && ResourceManager::GetInstance().GetTextureAtlas().GetTexture(m_AtlasRegion, imageResource, texture))
+	{
+		out_Origin = i2(m_AtlasRegion.m_X + m_Metadata.m_SheetLeft, m_AtlasRegion.m_Y + m_Metadata.m_SheetTop);
+		out_Size = i2(TextureAtlas::s_PageSize, TextureAtlas::s_PageSize);
+		return texture;
+	}
+
+	out_Origin = i2(m_Metadata.m_SheetLeft, m_Metadata.m_SheetTop);
+	out_Size = i2(m_Metadata.m_SheetWidth, m_Metadata.m_SheetHeight);
+	return imageResource.GetTexture();
+}
+
+// Calculates the bottom-left and top-right UVs based on the frame number and the layout returned by GetTexture
+void Engine::SpriteSheetResource::CalculateUVs(unsigned int frame, const i2& origin, const i2& size, f2& out_UV1, f2& out_UV2) const
 {	
 	// Calculate the coordinates in pixel space (y-axis pointing down, values in range [0, width] x [0, height])
-	out_UV1.x((float)(m_Metadata.m_SheetLeft + (frame % m_Metadata.m_SheetColumns) * (m_Metadata.m_SheetSeparationX + m_Metadata.m_SpriteWidth)));
+	out_UV1.x((float)(origin.x() + (frame % m_Metadata.m_SheetColumns) * (m_Metadata.m_SheetSeparationX + m_Metadata.m_SpriteWidth)));
 	out_UV2.x((float)(out_UV1.x() + m_Metadata.m_SpriteWidth));
-	out_UV1.y((float)(m_Metadata.m_SheetTop + (int)(frame / m_Metadata.m_SheetColumns) * (m_Metadata.m_SheetSeparationY + m_Metadata.m_SpriteHeight)));
+	out_UV1.y((float)(origin.y() + (int)(frame / m_Metadata.m_SheetColumns) * (m_Metadata.m_SheetSeparationY + m_Metadata.m_SpriteHeight)));
 	out_UV2.y((float)(out_UV1.y() + m_Metadata.m_SpriteHeight));
 
 	// Convert the coordinates to UV-space (y-axis pointing up, values in range [0, 1] x [0, 1])
-	out_UV1.x() /= m_Metadata.m_SheetWidth;
-	out_UV2.x() /= m_Metadata.m_SheetWidth;
-	out_UV1.y(1.0f - (out_UV1.y() / m_Metadata.m_SheetHeight));
-	out_UV2.y(1.0f - (out_UV2.y() / m_Metadata.m_SheetHeight));
+	out_UV1.x() /= size.x();
+	out_UV2.x() /= size.x();
+	out_UV1.y(1.0f - (out_UV1.y() / size.y()));
+	out_UV2.y(1.0f - (out_UV2.y() / size.y()));
 }
 
 // Writes the sprite sheet metadata to a file
@@ -64,6 +86,7 @@ void Engine::SpriteSheetResource::SaveFile(const std::string& filename)
 	// Write sheet layout metadata
 	XMLElement elementSheet = XMLFileIO::AddElement(file, "SpriteSheet");
 	XMLFileIO::SetAttributeValue(elementSheet, "ImageResource", m_FilenameImage);
+	XMLFileIO::SetAttributeValue(elementSheet, "PackInAtlas", m_Metadata.m_PackInAtlas ? "true" : "false");
 	XMLElement elementLayout = XMLFileIO::AddElement(elementSheet, "SheetLayout");
 	XMLFileIO::SetAttributeValue(elementLayout, "SpriteWidth", std::to_string(m_Metadata.m_SpriteWidth));
 	XMLFileIO::SetAttributeValue(elementLayout, "SpriteHeight", std::to_string(m_Metadata.m_SpriteHeight));
@@ -97,6 +120,7 @@ void Engine::SpriteSheetResource::LoadFile(const std::string& filename)
 	// Write sheet layout metadata
 	XMLElement elementSheet = XMLFileIO::GetElement(file, "SpriteSheet");
 	XMLFileIO::GetAttribute(elementSheet, "ImageResource", m_FilenameImage);
+	XMLFileIO::GetAttributeAsBoolean(elementSheet, "PackInAtlas", m_Metadata.m_PackInAtlas);
 	XMLElement elementLayout = XMLFileIO::GetElement(elementSheet, "SheetLayout");
 	XMLFileIO::GetAttributeAsUnsignedInteger(elementLayout, "SpriteWidth", m_Metadata.m_SpriteWidth);
 	XMLFileIO::GetAttributeAsUnsignedInteger(elementLayout, "SpriteHeight", m_Metadata.m_SpriteHeight);
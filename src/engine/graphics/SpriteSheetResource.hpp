@@ -4,6 +4,7 @@
 
 #include "../resources/Resource.hpp" // Interface for resources (implements reference counting)
 #include "../graphics/ImageResource.hpp" // For storing the image associated to the sprite sheet
+#include "../graphics/TextureAtlas.hpp" // For storing the region of the texture atlas the sprite sheet is packed in
 
 #include <string> // For representing a sprite sheet filename
 
@@ -64,11 +65,18 @@ namespace Engine
 			unsigned int m_ColorTransparancyGreen = 255;
 			unsigned int m_ColorTransparancyBlue = 255;
 			unsigned int m_ColorTransparancyAlpha = 255;
+
+			// Texture atlas
+			bool m_PackInAtlas = true;
 		};
 
 		// Sprite sheet specifications
 		Metadata m_Metadata;
 
+		// Whether the image of the sprite sheet is packed in the texture atlas, and the region it is packed in (set when loading)
+		bool m_PackedInAtlas;
+		TextureAtlas::Region m_AtlasRegion;
+
 	public:
 
 		////////////////////////////////////////////////////////////////
@@ -93,8 +101,11 @@ namespace Engine
 			out_P2.y(m_Metadata.m_SpriteHeight - m_Metadata.m_SpriteOriginY);
 		}
 
-		// Calculates the bottom-left and top-right UVs based on the frame number
-		void CalculateUVs(unsigned int frame, f2& out_UV1, f2& out_UV2) const;
+		// Gets the texture the sprite sheet is drawn from (the page of the texture atlas it is packed in, or its own image), and the top-left position of the sheet layout and the size of that texture in pixels
+		GLuint GetTexture(i2& out_Origin, i2& out_Size);
+
+		// Calculates the bottom-left and top-right UVs based on the frame number and the layout returned by GetTexture
+		void CalculateUVs(unsigned int frame, const i2& origin, const i2& size, f2& out_UV1, f2& out_UV2) const;
 
 		// Writes the sprite sheet metadata to a file
 		void SaveFile(const std::string& filename);
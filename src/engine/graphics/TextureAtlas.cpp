@@ -0,0 +1,262 @@
+#include "TextureAtlas.hpp"
+
+#include "GraphicsManager.hpp" // For calling OpenGL on the thread that owns the OpenGL context
+
+#include <climits> // For INT_MAX
+#include <algorithm> // For growing the changed area of a page
+
+// Adds a reservation for an image, packing it if it is not packed yet, and gets the region it is packed in (returns whether the image is packed)
+bool Engine::TextureAtlas::Add(const Image& image, ImageResource& imageResource, Region& out_Region)
+{
+	auto i = m_Entries.find(image);
+	if (i != m_Entries.end())
+	{
+		i->second.m_Reservations++;
+		out_Region = i->second.m_Region;
+		return true;
+	}
+
+	// Only pack color images that fit inside a page (other images keep their own texture)
+	if (imageResource.m_Image == NULL) { return false; }
+	if (imageResource.m_ImageFormat != ImageResource::ImageFormat::RGB && imageResource.m_ImageFormat != ImageResource::ImageFormat::RGBA) { return false; }
+	i2 dim = imageResource.GetDimensions();
+	int width = dim.x() + 2 * s_Padding;
+	int height = dim.y() + 2 * s_Padding;
+	if (width > s_PageSize || height > s_PageSize) { return false; }
+
+	// Pack the image into the first page it fits in, or into a new page
+	Entry entry;
+	Region& region = entry.m_Region;
+	region.m_Width = dim.x();
+	region.m_Height = dim.y();
+	entry.m_Reservations = 1;
+	region.m_Page = m_Pages.size();
+	for (size_t p = 0; p < m_Pages.size(); p++)
+	{
+		if (m_Pages[p] != NULL && Insert(*m_Pages[p], width, height, region.m_X, region.m_Y)) { region.m_Page = p; break; }
+	}
+	if (region.m_Page == m_Pages.size())
+	{
+		// Reuse the slot of a removed page, if any
+		for (size_t p = 0; p < m_Pages.size(); p++)
+		{
+			if (m_Pages[p] == NULL) { region.m_Page = p; break; }
+		}
+		if (region.m_Page == m_Pages.size()) { m_Pages.push_back(NULL); }
+
+		Page* page = new Page();
+		page->m_Bitmap = FreeImage_Allocate(s_PageSize, s_PageSize, 32);
+		page->m_Texture = 0;
+		SkylineNode node = { 0, 0, s_PageSize };
+		page->m_Skyline.push_back(node);
+		page->m_NumImages = 0;
+		page->m_DirtyX1 = s_PageSize;
+		page->m_DirtyX2 = 0;
+		page->m_DirtyY1 = s_PageSize;
+		page->m_DirtyY2 = 0;
+		m_Pages[region.m_Page] = page;
+		Insert(*page, width, height, region.m_X, region.m_Y);
+	}
+	region.m_X += s_Padding;
+	region.m_Y += s_Padding;
+
+	m_Pages[region.m_Page]->m_NumImages++;
+	Paste(region, imageResource);
+	m_Entries.insert(std::pair<Image, Entry>(image, entry));
+
+	out_Region = region;
+	return true;
+}
+
+// Removes a reservation for an image, removing it from its page if no more reservations exist
+void Engine::TextureAtlas::Remove(const Image& image)
+{
+	auto i = m_Entries.find(image);
+	if (i == m_Entries.end()) { return; }
+
+	Entry& entry = i->second;
+	entry.m_Reservations--;
+	if (entry.m_Reservations > 0) { return; }
+
+	size_t page = entry.m_Region.m_Page;
+	m_Entries.erase(i);
+	m_Pages[page]->m_NumImages--;
+	if (m_Pages[page]->m_NumImages == 0) { RemovePage(page); }
+}
+
+// Gets the texture of the page a region belongs to, uploading the changes to the page first (returns false if the image no longer fits its region)
+bool Engine::TextureAtlas::GetTexture(const Region& region, ImageResource& imageResource, GLuint& out_Texture)
+{
+	// Images that were resized after packing are drawn from their own texture
+	i2 dim = imageResource.GetDimensions();
+	if (dim.x() != region.m_Width || dim.y() != region.m_Height) { return false; }
+
+	// Copy images that were modified after packing into the page again (and keep their own texture up to date)
+	Page& page = *m_Pages[region.m_Page];
+	if (imageResource.m_Dirty != ImageResource::DirtyType::CLEAN)
+	{
+		Paste(region, imageResource);
+		imageResource.GetTexture();
+	}
+	UploadPage(page);
+
+	out_Texture = page.m_Texture;
+	return true;
+}
+
+// Removes all images and pages
+void Engine::TextureAtlas::Clear()
+{
+	for (size_t p = 0; p < m_Pages.size(); p++)
+	{
+		if (m_Pages[p] != NULL) { RemovePage(p); }
+	}
+	m_Pages.clear();
+	m_Entries.clear();
+}
+
+// Finds a position for a rectangle in a page (returns whether the rectangle fits)
+bool Engine::TextureAtlas::Insert(Page& page, int width, int height, int& out_X, int& out_Y)
+{
+	// Find the node where the rectangle ends up highest (and then where it fits most tightly)
+	std::vector<SkylineNode>& skyline = page.m_Skyline;
+	size_t bestNode = skyline.size();
+	int bestBottom = INT_MAX;
+	int bestWidth = INT_MAX;
+	for (size_t i = 0; i < skyline.size(); i++)
+	{
+		int y;
+		if (!Fits(page, i, width, height, y)) { continue; }
+		if (y + height < bestBottom || (y + height == bestBottom && skyline[i].m_Width < bestWidth))
+		{
+			bestNode = i;
+			bestBottom = y + height;
+			bestWidth = skyline[i].m_Width;
+			out_X = skyline[i].m_X;
+			out_Y = y;
+		}
+	}
+	if (bestNode == skyline.size()) { return false; }
+
+	// Raise the skyline over the rectangle, and shrink or remove the nodes it covers
+	SkylineNode node = { out_X, bestBottom, width };
+	skyline.insert(skyline.begin() + bestNode, node);
+	for (size_t i = bestNode + 1; i < skyline.size();)
+	{
+		int shrink = skyline[i - 1].m_X + skyline[i - 1].m_Width - skyline[i].m_X;
+		if (shrink <= 0) { break; }
+		skyline[i].m_X += shrink;
+		skyline[i].m_Width -= shrink;
+		if (skyline[i].m_Width > 0) { break; }
+		skyline.erase(skyline.begin() + i);
+	}
+
+	// Merge neighbouring nodes at the same height
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].m_Y == skyline[i + 1].m_Y)
+		{
+			skyline[i].m_Width += skyline[i + 1].m_Width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else { i++; }
+	}
+
+	return true;
+}
+
+// Checks whether a rectangle fits at a node of the skyline, and gets the height it is placed at
+bool Engine::TextureAtlas::Fits(const Page& page, size_t node, int width, int height, int& out_Y) const
+{
+	const std::vector<SkylineNode>& skyline = page.m_Skyline;
+	if (skyline[node].m_X + width > s_PageSize) { return false; }
+
+	// Rest the rectangle on the highest node below it
+	int widthLeft = width;
+	out_Y = skyline[node].m_Y;
+	for (size_t i = node; widthLeft > 0; i++)
+	{
+		if (skyline[i].m_Y > out_Y) { out_Y = skyline[i].m_Y; }
+		if (out_Y + height > s_PageSize) { return false; }
+		widthLeft -= skyline[i].m_Width;
+	}
+	return true;
+}
+
+// Copies an image and its padding into its page
+void Engine::TextureAtlas::Paste(const Region& region, ImageResource& imageResource)
+{
+	Page& page = *m_Pages[region.m_Page];
+	FIBITMAP* image = imageResource.m_Image;
+	if (imageResource.m_ImageFormat == ImageResource::ImageFormat::RGB) { image = FreeImage_ConvertTo32Bits(imageResource.m_Image); }
+
+	// Paste the image shifted by the padding first, which repeats its edge pixels in the padding, and then in place
+	for (int y = -s_Padding; y <= s_Padding; y += s_Padding)
+	{
+		for (int x = -s_Padding; x <= s_Padding; x += s_Padding)
+		{
+			if (x == 0 && y == 0) { continue; }
+			FreeImage_Paste(page.m_Bitmap, image, region.m_X + x, region.m_Y + y, 256);
+		}
+	}
+	FreeImage_Paste(page.m_Bitmap, image, region.m_X, region.m_Y, 256);
+
+	if (image != imageResource.m_Image) { FreeImage_Unload(image); }
+
+	// Grow the changed area of the page to include the image and its padding
+	page.m_DirtyX1 = std::min(page.m_DirtyX1, region.m_X - s_Padding);
+	page.m_DirtyX2 = std::max(page.m_DirtyX2, region.m_X + region.m_Width + s_Padding);
+	page.m_DirtyY1 = std::min(page.m_DirtyY1, region.m_Y - s_Padding);
+	page.m_DirtyY2 = std::max(page.m_DirtyY2, region.m_Y + region.m_Height + s_Padding);
+}
+
+// Uploads the area of a page that changed since the last upload to the GPU
+void Engine::TextureAtlas::UploadPage(Page& page)
+{
+	if (page.m_DirtyX1 >= page.m_DirtyX2) { return; }
+
+	// Upload on the thread that owns the OpenGL context (the render thread, if enabled)
+	GraphicsManager::GetInstance().RunOnRenderThread([&page]()
+	{
+		if (page.m_Texture == 0)
+		{
+			glGenTextures(1, &page.m_Texture);
+			glBindTexture(GL_TEXTURE_2D, page.m_Texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, s_PageSize, s_PageSize, 0, GL_BGRA, GL_UNSIGNED_BYTE, (void*)FreeImage_GetBits(page.m_Bitmap));
+		}
+		else
+		{
+			// Upload only the changed area, reading its rows from the full page (the bitmap stores its rows bottom-up, like OpenGL)
+			int width = page.m_DirtyX2 - page.m_DirtyX1;
+			int height = page.m_DirtyY2 - page.m_DirtyY1;
+			int bottom = s_PageSize - page.m_DirtyY2;
+			BYTE* bits = FreeImage_GetBits(page.m_Bitmap) + bottom * FreeImage_GetPitch(page.m_Bitmap) + page.m_DirtyX1 * 4;
+			glBindTexture(GL_TEXTURE_2D, page.m_Texture);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, s_PageSize);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, page.m_DirtyX1, bottom, width, height, GL_BGRA, GL_UNSIGNED_BYTE, (void*)bits);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
+	});
+
+	page.m_DirtyX1 = s_PageSize;
+	page.m_DirtyX2 = 0;
+	page.m_DirtyY1 = s_PageSize;
+	page.m_DirtyY2 = 0;
+}
+
+// Removes a page, deleting its texture
+void Engine::TextureAtlas::RemovePage(size_t page)
+{
+	Page* removed = m_Pages[page];
+	if (removed->m_Texture != 0)
+	{
+		// Delete the texture once the frames that may still draw from the page are submitted
+		GLuint texture = removed->m_Texture;
+		GraphicsManager::GetInstance().ReleaseOnRenderThread([texture]() { glDeleteTextures(1, &texture); });
+	}
+	FreeImage_Unload(removed->m_Bitmap);
+	delete removed;
+	m_Pages[page] = NULL;
+}
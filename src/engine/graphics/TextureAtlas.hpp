@@ -0,0 +1,110 @@
+#pragma once
+#ifndef ENGINE_GRAPHICS_TEXTUREATLAS_H
+#define ENGINE_GRAPHICS_TEXTUREATLAS_H
+
+#include "../graphics/ImageResource.hpp" // For packing the images of sprite sheets
+
+#include <vector> // For holding the atlas pages and their skylines
+#include <unordered_map> // For storing the packed images by handle
+
+namespace Engine
+{
+	// Atlas that packs the images of sprite sheets (and bitmap fonts) into shared textures
+	//		NOTE: images are packed into square pages at load time (skyline
+	//		bottom-left bin packing), so sprite sheets that share a page are
+	//		drawn without switching textures. Every image is surrounded by a
+	//		border that repeats its edge pixels, so nearest filtering never
+	//		samples a neighbouring image. Space in a page is only reclaimed
+	//		once all images in the page are removed. Only the part of a page
+	//		that changed since its last upload is uploaded again.
+	class TextureAtlas
+	{
+
+	public:
+
+		// Size of the atlas pages in pixels
+		static const int s_PageSize = 2048;
+
+		// Padding around every image in pixels
+		static const int s_Padding = 1;
+
+		// Region of a page an image is packed in (fixed for as long as the image is packed)
+		struct Region
+		{
+			size_t m_Page;
+			int m_X; // Position of the image in the page (y-axis pointing down, excluding the padding)
+			int m_Y;
+			int m_Width;
+			int m_Height;
+		};
+
+		// Constructor
+		TextureAtlas() { }
+
+		// Adds a reservation for an image, packing it if it is not packed yet, and gets the region it is packed in (returns whether the image is packed)
+		bool Add(const Image& image, ImageResource& imageResource, Region& out_Region);
+
+		// Removes a reservation for an image, removing it from its page if no more reservations exist
+		void Remove(const Image& image);
+
+		// Gets the texture of the page a region belongs to, uploading the changes to the page first (returns false if the image no longer fits its region)
+		bool GetTexture(const Region& region, ImageResource& imageResource, GLuint& out_Texture);
+
+		// Removes all images and pages
+		void Clear();
+
+	private:
+
+		// Segment of the skyline of a page (the top of the area that is packed so far, y-axis pointing down)
+		struct SkylineNode
+		{
+			int m_X;
+			int m_Y;
+			int m_Width;
+		};
+
+		// Page of the atlas
+		struct Page
+		{
+			FIBITMAP* m_Bitmap;
+			GLuint m_Texture;
+			std::vector<SkylineNode> m_Skyline;
+			unsigned int m_NumImages;
+			int m_DirtyX1; // Area changed since the last upload (y-axis pointing down, empty if x1 >= x2)
+			int m_DirtyX2;
+			int m_DirtyY1;
+			int m_DirtyY2;
+		};
+
+		// Image packed into a page
+		struct Entry
+		{
+			Region m_Region;
+			unsigned int m_Reservations;
+		};
+
+		// Pages of the atlas (NULL if the page was removed)
+		std::vector<Page*> m_Pages;
+
+		// Packed images
+		std::unordered_map<Image, Entry> m_Entries;
+
+		// Finds a position for a rectangle in a page (returns whether the rectangle fits)
+		bool Insert(Page& page, int width, int height, int& out_X, int& out_Y);
+
+		// Checks whether a rectangle fits at a node of the skyline, and gets the height it is placed at
+		bool Fits(const Page& page, size_t node, int width, int height, int& out_Y) const;
+
+		// Copies an image and its padding into its page
+		void Paste(const Region& region, ImageResource& imageResource);
+
+		// Uploads the area of a page that changed since the last upload to the GPU
+		void UploadPage(Page& page);
+
+		// Removes a page, deleting its texture
+		void RemovePage(size_t page);
+
+	};
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "JobManager.hpp"
+
+// Initializes the job manager (starts one worker thread per additional hardware thread)
+void Engine::JobManager::Initialize()
+{
+	// The main thread runs jobs while waiting, so it gets a queue as well
+	unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	unsigned int threadCount = (hardwareThreads == 0) ? 1 : hardwareThreads;
+	for (unsigned int i = 0; i < threadCount; i++) { m_Queues.push_back(std::unique_ptr<JobQueue>(new JobQueue())); }
+
+	// Start the worker threads (after all queues exist, as workers steal from all queues)
+	s_ThreadIndex = 0;
+	m_QueuedJobCount = 0;
+	m_Running = true;
+	for (unsigned int i = 1; i < threadCount; i++) { m_Workers.push_back(std::thread(&JobManager::RunWorker, this, i)); }
+}
+
+// Terminates the job manager (stops all worker threads, unfinished jobs are discarded)
+void Engine::JobManager::Terminate()
+{
+	m_Running = false;
+	{ std::lock_guard<std::mutex> lock(m_IdleMutex); }
+	m_IdleCondition.notify_all();
+	for (std::thread& worker : m_Workers) { worker.join(); }
+	m_Workers.clear();
+	m_Queues.clear();
+}
+
+////////////////////////////////////////////////////////////////
+// Job scheduling                                             //
+////////////////////////////////////////////////////////////////
+
+// Schedules a job (the counter is decremented once the job has finished)
+void Engine::JobManager::Schedule(const Job& job, JobCounter* counter)
+{
+	if (counter != NULL) { counter->m_Count++; }
+	Enqueue(job, counter);
+}
+
+// Schedules a job that starts once all jobs of the dependency have finished
+void Engine::JobManager::Schedule(const Job& job, JobCounter& dependency, JobCounter* counter)
+{
+	if (counter != NULL) { counter->m_Count++; }
+
+	// Hold the job back until the last job of the dependency has finished
+	{
+		std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+		if (!dependency.IsDone()) { dependency.m_Dependents.push_back(std::pair<Job, JobCounter*>(job, counter)); return; }
+	}
+
+	Enqueue(job, counter);
+}
+
+// Waits for all jobs of the counter to finish (the calling thread runs queued jobs while waiting)
+void Engine::JobManager::Wait(JobCounter& counter)
+{
+	while (!counter.IsDone())
+	{
+		QueuedJob job;
+		if (TakeJob(job)) { RunJob(job); }
+		else { std::this_thread::yield(); }
+	}
+
+	// Make sure the thread that finished the last job no longer accesses the counter
+	std::lock_guard<std::mutex> lock(counter.m_Mutex);
+}
+
+////////////////////////////////////////////////////////////////
+// Threads                                                    //
+////////////////////////////////////////////////////////////////
+
+// Gets the index of the calling thread (0 for the main thread and threads not owned by the job manager)
+unsigned int Engine::JobManager::GetThreadIndex()
+{
+	return s_ThreadIndex;
+}
+
+// Queues a job on the queue of the calling thread
+void Engine::JobManager::Enqueue(const Job& job, JobCounter* counter)
+{
+	JobQueue& queue = *m_Queues[s_ThreadIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.m_Mutex);
+		QueuedJob queuedJob = { job, counter };
+		queue.m_Jobs.push_back(queuedJob);
+	}
+
+	// Wake up an idle worker (taking the idle mutex prevents the wake-up from being lost)
+	m_QueuedJobCount++;
+	{ std::lock_guard<std::mutex> lock(m_IdleMutex); }
+	m_IdleCondition.notify_one();
+}
+
+// Takes a job from the queue of the calling thread, or steals one from another thread (returns whether a job was found)
+bool Engine::JobManager::TakeJob(QueuedJob& out_Job)
+{
+	// Take the most recently queued job of the calling thread (its data is most likely still in cache)
+	JobQueue& queue = *m_Queues[s_ThreadIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.m_Mutex);
+		if (!queue.m_Jobs.empty())
+		{
+			out_Job = queue.m_Jobs.back();
+			queue.m_Jobs.pop_back();
+			m_QueuedJobCount--;
+			return true;
+		}
+	}
+
+	// Steal the oldest queued job of another thread
+	size_t queueCount = m_Queues.size();
+	for (size_t i = 1; i < queueCount; i++)
+	{
+		JobQueue& other = *m_Queues[(s_ThreadIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(other.m_Mutex);
+		if (!other.m_Jobs.empty())
+		{
+			out_Job = other.m_Jobs.front();
+			other.m_Jobs.pop_front();
+			m_QueuedJobCount--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Runs a job, and schedules the dependents of its counter if it was the last unfinished job
+void Engine::JobManager::RunJob(QueuedJob& job)
+{
+	job.m_Job();
+	if (job.m_Counter == NULL) { return; }
+
+	std::vector<std::pair<Job, JobCounter*>> dependents;
+	{
+		std::lock_guard<std::mutex> lock(job.m_Counter->m_Mutex);
+		if (--job.m_Counter->m_Count == 0) { dependents.swap(job.m_Counter->m_Dependents); }
+	}
+	for (auto& dependent : dependents) { Enqueue(dependent.first, dependent.second); }
+}
+
+// Main loop of worker threads
+void Engine::JobManager::RunWorker(unsigned int threadIndex)
+{
+	s_ThreadIndex = threadIndex;
+
+	while (m_Running)
+	{
+		QueuedJob job;
+		if (TakeJob(job)) { RunJob(job); continue; }
+
+		// Sleep until new jobs are queued
+		std::unique_lock<std::mutex> lock(m_IdleMutex);
+		m_IdleCondition.wait(lock, [this]() { return !m_Running || m_QueuedJobCount > 0; });
+	}
+}
+
+// Index of the calling thread
+thread_local unsigned int Engine::JobManager::s_ThreadIndex = 0;
@@ -0,0 +1,158 @@
+#pragma once
+#ifndef ENGINE_JOBS_JOBMANAGER_H
+#define ENGINE_JOBS_JOBMANAGER_H
+
+#include "../common/patterns/Singleton.hpp" // Singleton pattern
+
+#include <functional> // For representing jobs
+#include <vector> // For holding the worker threads and their job queues
+#include <deque> // For holding the jobs queued on a thread
+#include <memory> // For owning the job queues
+#include <atomic> // For counting unfinished jobs
+#include <mutex> // For guarding the job queues
+#include <condition_variable> // For waking up idle worker threads
+#include <thread> // For running worker threads
+
+namespace Engine{
+
+	// Typedef for jobs
+	typedef std::function<void()> Job;
+
+	// Counter of unfinished jobs, used for waiting on jobs and for expressing dependencies between jobs
+	class JobCounter
+	{
+
+	public:
+
+		// Constructor
+		JobCounter() : m_Count(0) { }
+
+		// Checks whether all jobs associated with the counter have finished
+		inline bool IsDone() const { return m_Count.load() == 0; }
+
+	private:
+
+		friend class JobManager;
+
+		// Number of unfinished jobs
+		std::atomic<unsigned int> m_Count;
+
+		// Mutex guarding the dependent jobs
+		std::mutex m_Mutex;
+
+		// Jobs that are scheduled once all jobs associated with the counter have finished
+		std::vector<std::pair<Job, JobCounter*>> m_Dependents;
+
+	};
+
+	class JobManager : public Singleton<JobManager>
+	{
+
+	public:
+
+		// Initializes the job manager (starts one worker thread per additional hardware thread)
+		void Initialize();
+
+		// Terminates the job manager (stops all worker threads, unfinished jobs are discarded)
+		void Terminate();
+
+		////////////////////////////////////////////////////////////////
+		// Job scheduling                                             //
+		////////////////////////////////////////////////////////////////
+
+		// Schedules a job (the counter is decremented once the job has finished)
+		void Schedule(const Job& job, JobCounter* counter = NULL);
+
+		// Schedules a job that starts once all jobs of the dependency have finished
+		void Schedule(const Job& job, JobCounter& dependency, JobCounter* counter = NULL);
+
+		// Waits for all jobs of the counter to finish (the calling thread runs queued jobs while waiting)
+		void Wait(JobCounter& counter);
+
+		// Runs a function over a range of indices in parallel, and waits for it to finish
+		//		NOTE: the function is called as f(begin, end) on sub-ranges of at most
+		//		grainSize indices. A grain size of 0 splits the range into a few
+		//		sub-ranges per thread.
+		template<typename function>
+		void ParallelFor(size_t begin, size_t end, const function& f, size_t grainSize = 0)
+		{
+			if (begin >= end) { return; }
+			if (grainSize == 0) { grainSize = (end - begin) / (GetThreadCount() * s_RangesPerThread); }
+			if (grainSize == 0) { grainSize = 1; }
+
+			// Run on the calling thread if the range does not need to be split
+			if (end - begin <= grainSize) { f(begin, end); return; }
+
+			JobCounter counter;
+			for (size_t rangeBegin = begin; rangeBegin < end; rangeBegin += grainSize)
+			{
+				size_t rangeEnd = (end - rangeBegin > grainSize) ? rangeBegin + grainSize : end;
+				Schedule([&f, rangeBegin, rangeEnd]() { f(rangeBegin, rangeEnd); }, &counter);
+			}
+			Wait(counter);
+		}
+
+		////////////////////////////////////////////////////////////////
+		// Threads                                                    //
+		////////////////////////////////////////////////////////////////
+
+		// Gets the number of threads that run jobs (including the main thread)
+		inline unsigned int GetThreadCount() const { return (unsigned int)m_Queues.size(); }
+
+		// Gets the index of the calling thread (0 for the main thread and threads not owned by the job manager)
+		static unsigned int GetThreadIndex();
+
+	private:
+
+		// Number of sub-ranges per thread when splitting parallel loops
+		static const size_t s_RangesPerThread = 4;
+
+		// Job and the counter it decrements when finished
+		struct QueuedJob
+		{
+			Job m_Job;
+			JobCounter* m_Counter;
+		};
+
+		// Job queue of a thread (the owning thread pops from the back, other threads steal from the front)
+		struct JobQueue
+		{
+			std::mutex m_Mutex;
+			std::deque<QueuedJob> m_Jobs;
+		};
+
+		// Job queues (indexed by thread index)
+		std::vector<std::unique_ptr<JobQueue>> m_Queues;
+
+		// Worker threads (the worker with thread index i is stored at i - 1)
+		std::vector<std::thread> m_Workers;
+
+		// Whether the worker threads keep running
+		std::atomic<bool> m_Running;
+
+		// Number of queued jobs that have not been started yet
+		std::atomic<unsigned int> m_QueuedJobCount;
+
+		// Mutex and condition variable for waking up idle worker threads
+		std::mutex m_IdleMutex;
+		std::condition_variable m_IdleCondition;
+
+		// Index of the calling thread
+		static thread_local unsigned int s_ThreadIndex;
+
+		// Queues a job on the queue of the calling thread
+		void Enqueue(const Job& job, JobCounter* counter);
+
+		// Takes a job from the queue of the calling thread, or steals one from another thread (returns whether a job was found)
+		bool TakeJob(QueuedJob& out_Job);
+
+		// Runs a job, and schedules the dependents of its counter if it was the last unfinished job
+		void RunJob(QueuedJob& job);
+
+		// Main loop of worker threads
+		void RunWorker(unsigned int threadIndex);
+
+	};
+}
+
+#endif
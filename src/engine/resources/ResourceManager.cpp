@@ -11,7 +11,8 @@ void Engine::ResourceManager::Initialize()
 // Terminates the resource manager
 void Engine::ResourceManager::Terminate()
 {
-
+	// Remove the pages of the texture atlas
+	m_TextureAtlas.Clear();
 }
 
 ////////////////////////////////////////////////////////////////
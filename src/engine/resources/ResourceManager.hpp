@@ -11,6 +11,7 @@
 #include "../graphics/ImageResource.hpp"
 #include "../graphics/SpriteSheetResource.hpp"
 #include "../graphics/BitmapFontResource.hpp"
+#include "../graphics/TextureAtlas.hpp"
 
 namespace Engine{
 
@@ -82,6 +83,18 @@ namespace Engine{
 		// Holds all bitmap font resources
 		std::unordered_map<BitmapFont, BitmapFontResource*> m_BitmapFontResources;
 
+		////////////////////////////////////////////////// Texture atlas
+
+	public:
+
+		// Gets the texture atlas that the images of sprite sheets are packed into
+		inline TextureAtlas& GetTextureAtlas() { return m_TextureAtlas; }
+
+	private:
+
+		// Texture atlas that the images of sprite sheets are packed into
+		TextureAtlas m_TextureAtlas;
+
 	};
 }
 
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ENGINE_WORLD_COLLIDER_H
+#define ENGINE_WORLD_COLLIDER_H
+
+#include "../common/utility/ShapeTypes.hpp" // For representing the shapes of colliders
+
+namespace Engine{
+
+	// Shape of a game object in collision-aware movement
+	//		NOTE: the collider is placed in the world AABB of the game object,
+	//		which keeps bounding the game object in the broadphase. Circles are
+	//		centered in the AABB, and should fit inside it. A moving circle
+	//		sweeps a capsule, which is tested exactly against the other shapes.
+	struct Collider
+	{
+
+		// Shapes of colliders
+		enum class Shape : unsigned char
+		{
+			AABB,	// The world AABB of the game object
+			CIRCLE	// Circle centered in the world AABB of the game object
+		};
+
+		// Number of shapes of colliders
+		static const size_t s_ShapeCount = 2;
+
+		// Shape of the collider
+		Shape m_Shape;
+
+		// Radius of the collider (for circles)
+		float m_Radius;
+
+		// Creates a collider that is the world AABB of the game object
+		static inline Collider AABB() { Collider collider = { Shape::AABB, 0.0f }; return collider; }
+
+		// Creates a collider that is a circle centered in the world AABB of the game object
+		static inline Collider Circle(float radius) { Collider collider = { Shape::CIRCLE, radius }; return collider; }
+
+	};
+
+	// Places the shape of a collider in the world AABB of a game object
+	template<Collider::Shape shape>
+	struct ColliderShape;
+
+	template<>
+	struct ColliderShape<Collider::Shape::AABB>
+	{
+		static inline const aabb2Df& Place(const Collider& collider, const aabb2Df& aabb) { return aabb; }
+	};
+
+	template<>
+	struct ColliderShape<Collider::Shape::CIRCLE>
+	{
+		static inline circlef Place(const Collider& collider, const aabb2Df& aabb) { return circlef(aabb.center(), collider.m_Radius); }
+	};
+}
+
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef ENGINE_WORLD_COLLISIONFILTER_H
+#define ENGINE_WORLD_COLLISIONFILTER_H
+
+#include <bitset> // For representing the set of game object types
+
+namespace Engine{
+
+	// Set of game object types and collision categories that are considered by collision queries
+	//		NOTE: a game object matches the filter if its type is in the filter,
+	//		or if any of its collision category bits is in the filter. The 
+	//		categories are stored in the broadphase with the game objects, so
+	//		queries skip game objects that do not match without visiting them.
+	class CollisionFilter
+	{
+
+	public:
+
+		// Number of game object types a filter can hold (game object types at or above this are never matched)
+		static const unsigned int s_MaxTypes = 256;
+
+		// Constructors
+		CollisionFilter() : m_Categories(0) { }
+		CollisionFilter(unsigned int type) : m_Categories(0) { Add(type); }
+
+		// Creates a filter that matches all game object types and collision categories
+		static inline CollisionFilter All() { CollisionFilter filter; filter.m_Types.set(); filter.m_Categories = ~0u; return filter; }
+
+		// Creates a filter that matches the game objects in any of the specified categories (e.g. the collision mask of a game object)
+		static inline CollisionFilter Categories(unsigned int categories) { CollisionFilter filter; filter.m_Categories = categories; return filter; }
+
+		// Adds a game object type to the filter
+		inline CollisionFilter& Add(unsigned int type) { if (type < s_MaxTypes) { m_Types.set(type); } return *this; }
+
+		// Removes a game object type from the filter
+		inline CollisionFilter& Remove(unsigned int type) { if (type < s_MaxTypes) { m_Types.reset(type); } return *this; }
+
+		// Adds collision categories to the filter
+		inline CollisionFilter& AddCategories(unsigned int categories) { m_Categories |= categories; return *this; }
+
+		// Removes collision categories from the filter
+		inline CollisionFilter& RemoveCategories(unsigned int categories) { m_Categories &= ~categories; return *this; }
+
+		// Checks whether the filter matches a game object with the specified type and collision categories
+		inline bool Matches(unsigned int type, unsigned int categories) const { return (m_Categories & categories) != 0 || (type < s_MaxTypes && m_Types.test(type)); }
+
+		// Operators
+		inline CollisionFilter operator| (const CollisionFilter& other) const { CollisionFilter filter; filter.m_Types = m_Types | other.m_Types; filter.m_Categories = m_Categories | other.m_Categories; return filter; }
+
+	private:
+
+		// Game object types in the filter
+		std::bitset<s_MaxTypes> m_Types;
+
+		// Collision categories in the filter
+		unsigned int m_Categories;
+
+	};
+}
+
+#endif
@@ -1,13 +1,355 @@
 #include "CollisionManager.hpp"
 
+#include <vector> // For collecting the game objects when changing the broadphase
+
 // Initializes the collision manager
 void Engine::CollisionManager::Initialize()
 {
-
+	// Start with an empty tree as broadphase
+	m_BroadphaseType = BroadphaseType::TREE;
+	m_Tree = DynamicAABBTree(s_TreeMargin);
+	m_Grid = SpatialHashGrid(16.0f, s_GridMargin);
+	m_Positions = DynamicAABBTree(s_PositionMargin);
+	m_StaticProxies = DynamicAABBTree(0.0f);
+	m_StaticGeometry.Clear();
+	m_StaticGeometryDirty = false;
+	m_UpdatingContacts = false;
 }
 
 // Destroys the collision manager
 void Engine::CollisionManager::Terminate()
 {
+	m_Tree.Clear();
+	m_Grid.Clear();
+	m_Positions.Clear();
+	m_StaticProxies.Clear();
+	m_StaticGeometry.Clear();
+	m_StaticSolids.clear();
+	m_ContactSensors.clear();
+	m_ContactPairs.clear();
+	m_ContactPairKeys.clear();
+	m_ContactMoved.clear();
+	m_ContactBeginEvents.clear();
+	m_ContactStayEvents.clear();
+	m_ContactEndEvents.clear();
+	m_PendingContactEndEvents.clear();
+	m_ContactReports.clear();
+}
+
+////////////////////////////////////////////////////////////////
+// Broadphase                                                 //
+////////////////////////////////////////////////////////////////
+
+// Selects the broadphase (moves the proxies of all game objects into the new broadphase)
+void Engine::CollisionManager::SetBroadphase(BroadphaseType type, float cellSize)
+{
+	// Collect the game objects of the current broadphase
+	std::vector<GameObject*> gameObjects;
+	if (m_BroadphaseType == BroadphaseType::TREE) { m_Tree.ForEachProxy([&gameObjects](GameObject* gameObject, ProxyID proxy) { gameObjects.push_back(gameObject); }); }
+	else { m_Grid.ForEachProxy([&gameObjects](GameObject* gameObject, ProxyID proxy) { gameObjects.push_back(gameObject); }); }
+
+	// Start the new broadphase empty, and add the game objects to it (the position tree and the static proxies are kept)
+	m_Tree = DynamicAABBTree(s_TreeMargin);
+	m_Grid = SpatialHashGrid(cellSize, s_GridMargin);
+	m_BroadphaseType = type;
+	for (GameObject* gameObject : gameObjects)
+	{
+		if (m_BroadphaseType == BroadphaseType::TREE) { gameObject->m_Proxy = m_Tree.CreateProxy(gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory); }
+		else { gameObject->m_Proxy = m_Grid.CreateProxy(gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory); }
+		MarkContactMoved(gameObject, true);
+	}
+}
+
+// Adds a game object to the broadphase (static game objects are added to the static proxies and the static geometry)
+void Engine::CollisionManager::AddProxy(GameObject* gameObject)
+{
+	gameObject->m_Static = gameObject->IsStatic();
+	if (gameObject->m_Static) { gameObject->m_Proxy = m_StaticProxies.CreateProxy(gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory); m_StaticGeometryDirty = true; }
+	else if (m_BroadphaseType == BroadphaseType::TREE) { gameObject->m_Proxy = m_Tree.CreateProxy(gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory); }
+	else { gameObject->m_Proxy = m_Grid.CreateProxy(gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory); }
+	f2 position(gameObject->t2D());
+	gameObject->m_PositionProxy = m_Positions.CreateProxy(aabb2Df(position.x(), position.x(), position.y(), position.y()), gameObject, gameObject->type(), gameObject->m_CollisionCategory);
+	gameObject->SetFlag(FLAG_BOUNDS_MOVED, false);
+	MarkContactMoved(gameObject, true);
+}
+
+// Removes a game object from the broadphase
+void Engine::CollisionManager::RemoveProxy(GameObject* gameObject)
+{
+	if (gameObject->m_Static) { m_StaticProxies.DestroyProxy(gameObject->m_Proxy); m_StaticGeometryDirty = true; }
+	else if (m_BroadphaseType == BroadphaseType::TREE) { m_Tree.DestroyProxy(gameObject->m_Proxy); }
+	else { m_Grid.DestroyProxy(gameObject->m_Proxy); }
+	m_Positions.DestroyProxy(gameObject->m_PositionProxy);
+	gameObject->m_Proxy = PROXY_INVALID;
+	gameObject->m_PositionProxy = PROXY_INVALID;
+
+	// End the contacts of the game object while it still exists
+	if (gameObject->m_ContactPairs > 0) { RemoveContactPairs(gameObject, false, m_PendingContactEndEvents); }
+	if (gameObject->m_Sensing) { DisableContacts(gameObject); }
+}
+
+// Moves the proxy of a game object to its current AABB
+void Engine::CollisionManager::UpdateProxy(GameObject* gameObject)
+{
+	if (gameObject->m_Proxy == PROXY_INVALID) { return; }
+	MoveProxy(gameObject, gameObject->aabb2D_world(), gameObject->t2D());
+	gameObject->SetFlag(FLAG_BOUNDS_MOVED, false);
+}
+
+// Moves the proxies of all game objects whose AABBs changed since the last synchronization (and rebuilds the static geometry if needed)
+void Engine::CollisionManager::SyncProxies(GameObjectDataStore& gameObjectData)
+{
+	for (size_t bi = 0; bi < gameObjectData.blockCount(); bi++)
+	{
+		GameObjectDataBlock& b = gameObjectData.block(bi);
+		for (size_t i = 0; i < b.m_Size; i++)
+		{
+			if ((b.m_Flags[i] & FLAG_BOUNDS_MOVED) == 0) { continue; }
+			if ((b.m_Flags[i] & FLAG_IN_WORLD) != 0) { MoveProxy(b.m_Owner[i], b.m_AABB2DWorld[i], b.m_Translation[i].xy()); }
+			b.m_Flags[i] &= ~FLAG_BOUNDS_MOVED;
+		}
+	}
+
+	// Rebuild the static geometry if static game objects were added, moved or removed
+	BakeStaticGeometry();
+}
+
+// Updates the collision categories of a game object in the broadphase (and the contacts it is reported in)
+void Engine::CollisionManager::UpdateProxyCategory(GameObject* gameObject)
+{
+	if (gameObject->m_Proxy == PROXY_INVALID) { return; }
+	if (gameObject->m_Static) { m_StaticProxies.SetCategory(gameObject->m_Proxy, gameObject->m_CollisionCategory); m_StaticGeometryDirty = true; }
+	else if (m_BroadphaseType == BroadphaseType::TREE) { m_Tree.SetCategory(gameObject->m_Proxy, gameObject->m_CollisionCategory); }
+	else { m_Grid.SetCategory(gameObject->m_Proxy, gameObject->m_CollisionCategory); }
+	m_Positions.SetCategory(gameObject->m_PositionProxy, gameObject->m_CollisionCategory);
+
+	// End the contacts that are no longer reported, and look for new ones in the next update
+	if (gameObject->m_ContactPairs > 0) { RemoveContactPairs(gameObject, true, m_PendingContactEndEvents); }
+	MarkContactMoved(gameObject, true);
+}
+
+// Enlarges the broadphase proxy of a game object to contain the specified area
+void Engine::CollisionManager::ReserveProxy(GameObject* gameObject, const aabb2Df& aabb)
+{
+	if (MoveBroadphaseProxy(gameObject, aabb)) { MarkContactMoved(gameObject, true); }
+}
+
+////////////////////////////////////////////////////////////////
+// Static geometry                                            //
+////////////////////////////////////////////////////////////////
+
+// Rebuilds the static geometry from the AABBs of the static game objects, if any static game object was added, moved or removed since it was last built
+void Engine::CollisionManager::BakeStaticGeometry()
+{
+	if (!m_StaticGeometryDirty) { return; }
+
+	m_StaticSolids.clear();
+	m_StaticProxies.ForEachProxy([this](GameObject* gameObject, ProxyID proxy)
+	{
+		StaticGeometry::Solid solid = { gameObject->aabb2D_world(), gameObject, gameObject->type(), gameObject->m_CollisionCategory };
+		m_StaticSolids.push_back(solid);
+	});
+	m_StaticGeometry.Bake(m_StaticSolids);
+	m_StaticGeometryDirty = false;
+}
+
+////////////////////////////////////////////////////////////////
+// Contacts                                                   //
+////////////////////////////////////////////////////////////////
+
+// Reports contacts of a game object with the game objects that match the filter (to the listener, if any, and in the contact events)
+void Engine::CollisionManager::EnableContacts(GameObject* gameObject, const CollisionFilter& filter, ContactListener* listener)
+{
+	ContactSensor sensor = { gameObject, filter, listener };
+	if (gameObject->m_Sensing)
+	{
+		// Change the filter, and end the contacts that are no longer reported
+		m_ContactSensors[gameObject->m_SensorIndex] = sensor;
+		if (gameObject->m_ContactPairs > 0) { RemoveContactPairs(gameObject, true, m_PendingContactEndEvents); }
+	}
+	else
+	{
+		gameObject->m_Sensing = true;
+		gameObject->m_SensorIndex = m_ContactSensors.size();
+		m_ContactSensors.push_back(sensor);
+	}
 
-}
\ No newline at end of file
+	// Look for the pairs of the game object in the next update
+	if (gameObject->m_Proxy != PROXY_INVALID) { MarkContactMoved(gameObject, true); }
+}
+
+// Stops reporting contacts of a game object (ends its current contacts)
+void Engine::CollisionManager::DisableContacts(GameObject* gameObject)
+{
+	if (!gameObject->m_Sensing) { return; }
+
+	// End the contacts that are only reported by the game object (its listener is no longer called)
+	m_ContactSensors[gameObject->m_SensorIndex].m_Filter = CollisionFilter();
+	if (gameObject->m_ContactPairs > 0) { RemoveContactPairs(gameObject, true, m_PendingContactEndEvents); }
+
+	// Move the last sensor into the place of the game object
+	size_t index = gameObject->m_SensorIndex;
+	m_ContactSensors[index] = m_ContactSensors.back();
+	m_ContactSensors[index].m_GameObject->m_SensorIndex = index;
+	m_ContactSensors.pop_back();
+	gameObject->m_Sensing = false;
+}
+
+// Updates the contact pairs, and reports the contacts that began, stayed and ended since the last update
+void Engine::CollisionManager::UpdateContacts(GameObjectDataStore& gameObjectData)
+{
+	m_ContactBeginEvents.clear();
+	m_ContactStayEvents.clear();
+	m_ContactEndEvents.swap(m_PendingContactEndEvents);
+	m_PendingContactEndEvents.clear();
+	m_ContactReports.clear();
+	m_UpdatingContacts = true;
+
+	// Find the new pairs of the game objects whose proxies moved (game objects removed in the meantime do not resolve)
+	for (GameObjectHandle handle : m_ContactMoved)
+	{
+		GameObject* gameObject = gameObjectData.Resolve(handle);
+		if (gameObject == NULL || !gameObject->HasFlag(FLAG_PROXY_MOVED) || gameObject->m_Proxy == PROXY_INVALID) { continue; }
+		QueryProxies(GetProxyAABB(gameObject), [&](GameObject* other)
+		{
+			if (other != gameObject && IsContactPair(gameObject, other)) { AddContactPair(gameObject, other); }
+		});
+	}
+
+	// Test the pairs with a game object that moved again (the contacts of other pairs stay as they are)
+	for (size_t i = 0; i < m_ContactPairs.size();)
+	{
+		ContactPair& pair = m_ContactPairs[i];
+		if (pair.m_A->HasFlag(FLAG_CONTACT_MOVED) || pair.m_B->HasFlag(FLAG_CONTACT_MOVED))
+		{
+			// Drop pairs whose proxies no longer overlap
+			if (!IsIntersecting(GetProxyAABB(pair.m_A), GetProxyAABB(pair.m_B))) { RemoveContactPair(i, m_ContactEndEvents); continue; }
+
+			bool touching = IsIntersecting(pair.m_A->aabb2D_world(), pair.m_B->aabb2D_world());
+			if (touching != pair.m_Touching)
+			{
+				pair.m_Touching = touching;
+				if (touching) { ReportContact(ContactEvent::BEGIN, pair, m_ContactBeginEvents); }
+				else { ReportContact(ContactEvent::END, pair, m_ContactEndEvents); }
+				i++;
+				continue;
+			}
+		}
+		if (pair.m_Touching) { ReportContact(ContactEvent::STAY, pair, m_ContactStayEvents); }
+		i++;
+	}
+
+	// Start tracking moved game objects anew
+	for (GameObjectHandle handle : m_ContactMoved)
+	{
+		GameObject* gameObject = gameObjectData.Resolve(handle);
+		if (gameObject != NULL) { gameObject->SetFlag(GameObjectFlags(FLAG_CONTACT_MOVED | FLAG_PROXY_MOVED), false); }
+	}
+	m_ContactMoved.clear();
+	m_UpdatingContacts = false;
+
+	// Call the listeners last, so game objects they add, move or stop sensing are handled in the next update
+	for (size_t i = 0; i < m_ContactReports.size(); i++)
+	{
+		ContactReport report = m_ContactReports[i];
+		CallContactListeners(report.m_Type, report.m_A, report.m_B);
+	}
+	m_ContactReports.clear();
+}
+
+// Adds a pair of game objects to the contact pairs (if it is not cached already)
+void Engine::CollisionManager::AddContactPair(GameObject* a, GameObject* b)
+{
+	// Order the game objects by handle, so pairs are reported in the same order in every run
+	if (GameObjectGUID(b->handle()) < GameObjectGUID(a->handle())) { GameObject* swap = a; a = b; b = swap; }
+	ContactPairKey key = { a, b };
+	if (!m_ContactPairKeys.insert(key).second) { return; }
+
+	ContactPair pair = { a, b, false };
+	m_ContactPairs.push_back(pair);
+	a->m_ContactPairs++;
+	b->m_ContactPairs++;
+}
+
+// Removes a contact pair (moves the last pair into its place, and ends its contact)
+void Engine::CollisionManager::RemoveContactPair(size_t index, std::vector<Contact>& out_EndEvents)
+{
+	ContactPair pair = m_ContactPairs[index];
+	if (pair.m_Touching) { ReportContact(ContactEvent::END, pair, out_EndEvents); }
+
+	ContactPairKey key = { pair.m_A, pair.m_B };
+	m_ContactPairKeys.erase(key);
+	pair.m_A->m_ContactPairs--;
+	pair.m_B->m_ContactPairs--;
+	m_ContactPairs[index] = m_ContactPairs.back();
+	m_ContactPairs.pop_back();
+}
+
+// Removes the contact pairs of a game object (all of them, or only the ones that are no longer reported)
+void Engine::CollisionManager::RemoveContactPairs(GameObject* gameObject, bool unreportedOnly, std::vector<Contact>& out_EndEvents)
+{
+	for (size_t i = 0; i < m_ContactPairs.size() && gameObject->m_ContactPairs > 0;)
+	{
+		const ContactPair& pair = m_ContactPairs[i];
+		if ((pair.m_A == gameObject || pair.m_B == gameObject) && (!unreportedOnly || !IsContactPair(pair.m_A, pair.m_B))) { RemoveContactPair(i, out_EndEvents); }
+		else { i++; }
+	}
+}
+
+// Reports a contact event of a pair (to the listeners of its game objects, and in the specified events)
+void Engine::CollisionManager::ReportContact(ContactEvent type, const ContactPair& pair, std::vector<Contact>& out_Events)
+{
+	Contact contact = { pair.m_A->handle(), pair.m_B->handle() };
+	out_Events.push_back(contact);
+
+	// Queue the listener calls while the contacts are updated
+	if (m_UpdatingContacts)
+	{
+		ContactReport report = { type, pair.m_A, pair.m_B };
+		m_ContactReports.push_back(report);
+		return;
+	}
+	CallContactListeners(type, pair.m_A, pair.m_B);
+}
+
+// Calls the listeners of the game objects of a contact event
+void Engine::CollisionManager::CallContactListeners(ContactEvent type, GameObject* a, GameObject* b)
+{
+	GameObject* gameObjects[2] = { a, b };
+	for (int i = 0; i < 2; i++)
+	{
+		GameObject* gameObject = gameObjects[i];
+		GameObject* other = gameObjects[1 - i];
+		if (!gameObject->m_Sensing) { continue; }
+		const ContactSensor& sensor = m_ContactSensors[gameObject->m_SensorIndex];
+		if (sensor.m_Listener == NULL || !sensor.m_Filter.Matches(other->type(), other->m_CollisionCategory)) { continue; }
+		switch (type)
+		{
+		case ContactEvent::BEGIN:
+			sensor.m_Listener->ProcessContactBeginEvent(gameObject, other);
+			break;
+		case ContactEvent::STAY:
+			sensor.m_Listener->ProcessContactStayEvent(gameObject, other);
+			break;
+		case ContactEvent::END:
+			sensor.m_Listener->ProcessContactEndEvent(gameObject, other);
+			break;
+		}
+	}
+}
+
+// Margin by which the AABBs in the tree are enlarged
+const float Engine::CollisionManager::s_TreeMargin = 8.0f;
+
+// Margin by which the AABBs in the grid are enlarged
+const float Engine::CollisionManager::s_GridMargin = 2.0f;
+
+// Margin by which the positions in the position tree are enlarged
+const float Engine::CollisionManager::s_PositionMargin = 8.0f;
+
+// Swept tests between all pairs of shapes of colliders (indexed by the shape of the moving collider, then the other collider)
+const Engine::CollisionManager::ColliderTest Engine::CollisionManager::s_ColliderTests[Collider::s_ShapeCount][Collider::s_ShapeCount] =
+{
+	{ &IsIntersectingColliders<Collider::Shape::AABB, Collider::Shape::AABB>, &IsIntersectingColliders<Collider::Shape::AABB, Collider::Shape::CIRCLE> },
+	{ &IsIntersectingColliders<Collider::Shape::CIRCLE, Collider::Shape::AABB>, &IsIntersectingColliders<Collider::Shape::CIRCLE, Collider::Shape::CIRCLE> }
+};
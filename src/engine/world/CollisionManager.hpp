@@ -6,6 +6,18 @@
 #include "../common/utility/IntervalTypes.hpp" // For representing AABBs
 #include "../common/utility/VectorTypes.hpp" // For representing positions
 #include "../common/utility/ShapeTypes.hpp" // For representing collision shapes
+#include "GameObject.hpp" // For testing the AABBs of game objects in the broadphase
+#include "GameObjectData.hpp" // For synchronizing the broadphase with the moved game objects
+#include "DynamicAABBTree.hpp" // For finding collision candidates without testing all game objects
+#include "SpatialHashGrid.hpp" // For finding collision candidates in worlds of similarly sized game objects
+#include "CollisionFilter.hpp" // For filtering collision candidates by game object type
+#include "NearestGameObjectHeap.hpp" // For collecting the nearest game objects to a position
+#include "ContactListener.hpp" // For reporting contacts between game objects
+#include "StaticGeometry.hpp" // For resolving movement against merged level geometry
+#include "Collider.hpp" // For dispatching swept tests on the shapes of game objects
+
+#include <vector> // For holding the contact sensors, contact pairs and contact events
+#include <unordered_set> // For looking up cached contact pairs
 
 namespace Engine{
 
@@ -20,6 +32,212 @@ namespace Engine{
 		// Destroys the collision manager
 		void Terminate();
 
+		////////////////////////////////////////////////////////////////
+		// Broadphase                                                 //
+		////////////////////////////////////////////////////////////////
+
+		// Types of broadphases
+		enum class BroadphaseType
+		{
+			TREE,	// Dynamic AABB tree (suits game objects of all sizes)
+			GRID	// Uniform grid hashed by cell (suits dense worlds of game objects about the size of a cell)
+		};
+
+		// Selects the broadphase (moves the proxies of all game objects into the new broadphase)
+		//		NOTE: the cell size is only used by the grid. The broadphase 
+		//		must not be changed while game objects are updated in parallel.
+		void SetBroadphase(BroadphaseType type, float cellSize = 16.0f);
+
+		// Gets the type of the broadphase
+		inline BroadphaseType GetBroadphase() const { return m_BroadphaseType; }
+
+		// Adds a game object to the broadphase (static game objects are added to the static proxies and the static geometry)
+		void AddProxy(GameObject* gameObject);
+
+		// Removes a game object from the broadphase
+		void RemoveProxy(GameObject* gameObject);
+
+		// Moves the proxy of a game object to its current AABB
+		//		NOTE: the broadphase is not thread-safe for changes. Proxies
+		//		must not be moved while other threads query the broadphase.
+		void UpdateProxy(GameObject* gameObject);
+
+		// Moves the proxies of all game objects whose AABBs changed since the last synchronization (and rebuilds the static geometry if needed)
+		void SyncProxies(GameObjectDataStore& gameObjectData);
+
+		// Updates the collision categories of a game object in the broadphase (and the contacts it is reported in)
+		void UpdateProxyCategory(GameObject* gameObject);
+
+		// Enlarges the broadphase proxy of a game object to contain the specified area (e.g. the area it can reach while moving)
+		//		NOTE: the proxy keeps the enlarged AABB until the AABB of the game
+		//		object leaves it, so the game object is found anywhere within the 
+		//		area without moving the proxy.
+		void ReserveProxy(GameObject* gameObject, const aabb2Df& aabb);
+
+		// Gets the (enlarged) AABB of the broadphase proxy of a game object
+		inline const aabb2Df& GetProxyAABB(const GameObject* gameObject) const
+		{
+			if (gameObject->m_Static) { return m_StaticProxies.fatAABB(gameObject->m_Proxy); }
+			return (m_BroadphaseType == BroadphaseType::TREE) ? m_Tree.fatAABB(gameObject->m_Proxy) : m_Grid.fatAABB(gameObject->m_Proxy);
+		}
+
+		// Calls a function on all game objects whose broadphase proxy overlaps with the specified area (without testing their AABBs)
+		template<typename function>
+		inline void QueryProxies(const aabb2Df& aabb, function f) const
+		{
+			if (m_BroadphaseType == BroadphaseType::TREE) { m_Tree.Query(aabb, [&](GameObject* gameObject, ProxyID proxy) { f(gameObject); }); }
+			else { m_Grid.Query(aabb, [&](GameObject* gameObject, ProxyID proxy) { f(gameObject); }); }
+			m_StaticProxies.Query(aabb, [&](GameObject* gameObject, ProxyID proxy) { f(gameObject); });
+		}
+
+		// Calls a function on all game objects that match the filter and whose AABB overlaps with the specified area
+		//		NOTE: game objects are found through their fat AABBs in the
+		//		broadphase. Game objects that moved since their proxy was last
+		//		updated are found as long as they stay within the margin.
+		template<typename function>
+		inline void QueryOverlap(const aabb2Df& aabb, const CollisionFilter& filter, function f) const
+		{
+			QueryBroadphase(aabb, filter, f);
+			m_StaticProxies.Query(aabb, [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (filter.Matches(m_StaticProxies.tag(proxy), m_StaticProxies.category(proxy)) && IsIntersecting(gameObject->aabb2D_world_uncached(), aabb)) { f(gameObject); }
+			});
+		}
+
+		// Calls a function on all game objects that match the filter and whose AABB overlaps with the AABB swept along the specified motion
+		//		NOTE: static game objects are not included, as moving game objects
+		//		collide with the merged rectangles of the static geometry instead
+		//		(see QueryStaticSwept).
+		template<typename function>
+		inline void QuerySwept(const aabb2Df& aabb, const f2& motion, const CollisionFilter& filter, function f) const
+		{
+			QueryBroadphase(aabb.sweep(motion), filter, f);
+		}
+
+		// Gets the number of game objects in the broadphase (including the static game objects)
+		inline size_t GetProxyCount() const { return ((m_BroadphaseType == BroadphaseType::TREE) ? m_Tree.size() : m_Grid.size()) + m_StaticProxies.size(); }
+
+		////////////////////////////////////////////////////////////////
+		// Nearest neighbours                                         //
+		////////////////////////////////////////////////////////////////
+
+		// Offers the game objects that match the filter to a nearest game object heap, by their squared distance to a position considering x and y coordinates
+		//		NOTE: the positions of all game objects are kept in a separate
+		//		tree, which is searched nearest subtrees first. Subtrees that 
+		//		cannot hold game objects nearer than the farthest game object in
+		//		the heap are skipped. Like the broadphase, the tree is updated 
+		//		after game objects moved, within the margin of the tree.
+		template<typename valuetype>
+		inline void QueryNearest(const vector2D<valuetype>& position, const CollisionFilter& filter, NearestGameObjectHeap& heap) const
+		{
+			float bound = heap.bound();
+			m_Positions.QueryNearest(position, bound, [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (!filter.Matches(m_Positions.tag(proxy), m_Positions.category(proxy))) { return; }
+				vector2D<valuetype> d(gameObject->t2D() - position);
+				heap.Offer(d * d, gameObject);
+				bound = heap.bound();
+			});
+		}
+
+		// Offers the game objects that match the filter to a nearest game object heap, by their squared distance to a position considering x, y and z coordinates
+		//		NOTE: the tree only holds x and y coordinates, which bound the 
+		//		distance considering x, y and z coordinates from below.
+		template<typename valuetype>
+		inline void QueryNearest(const vector3D<valuetype>& position, const CollisionFilter& filter, NearestGameObjectHeap& heap) const
+		{
+			float bound = heap.bound();
+			m_Positions.QueryNearest(position.xy(), bound, [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (!filter.Matches(m_Positions.tag(proxy), m_Positions.category(proxy))) { return; }
+				vector3D<valuetype> d(gameObject->t() - position);
+				heap.Offer(d * d, gameObject);
+				bound = heap.bound();
+			});
+		}
+
+		// Calls a function on all game objects that match the filter within a distance of a position considering x and y coordinates
+		template<typename valuetype, typename function>
+		inline void QueryRadius(const vector2D<valuetype>& position, valuetype maxDistance, const CollisionFilter& filter, function f) const
+		{
+			valuetype maxDistanceSquared = maxDistance * maxDistance;
+			m_Positions.Query(aabb2Df(position.x() - maxDistance, position.x() + maxDistance, position.y() - maxDistance, position.y() + maxDistance), [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (!filter.Matches(m_Positions.tag(proxy), m_Positions.category(proxy))) { return; }
+				vector2D<valuetype> d(gameObject->t2D() - position);
+				if (d * d <= maxDistanceSquared) { f(gameObject); }
+			});
+		}
+
+		// Calls a function on all game objects that match the filter within a distance of a position considering x, y and z coordinates
+		template<typename valuetype, typename function>
+		inline void QueryRadius(const vector3D<valuetype>& position, valuetype maxDistance, const CollisionFilter& filter, function f) const
+		{
+			valuetype maxDistanceSquared = maxDistance * maxDistance;
+			m_Positions.Query(aabb2Df(position.x() - maxDistance, position.x() + maxDistance, position.y() - maxDistance, position.y() + maxDistance), [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (!filter.Matches(m_Positions.tag(proxy), m_Positions.category(proxy))) { return; }
+				vector3D<valuetype> d(gameObject->t() - position);
+				if (d * d <= maxDistanceSquared) { f(gameObject); }
+			});
+		}
+
+		////////////////////////////////////////////////////////////////
+		// Static geometry                                            //
+		////////////////////////////////////////////////////////////////
+
+		// Rebuilds the static geometry from the AABBs of the static game objects, if any static game object was added, moved or removed since it was last built
+		//		NOTE: called when the proxies are synchronized and at the start
+		//		of every update, so the static geometry is rebuilt once after a 
+		//		level is loaded rather than for every static game object. It must
+		//		not be rebuilt while game objects are updated in parallel.
+		void BakeStaticGeometry();
+
+		// Calls a function on all merged rectangles of the static geometry that match the filter and overlap with the AABB swept along the specified motion
+		//		NOTE: the function is called as f(aabb, gameObject), with the
+		//		first static game object merged into the rectangle.
+		template<typename function>
+		inline void QueryStaticSwept(const aabb2Df& aabb, const f2& motion, const CollisionFilter& filter, function f) const
+		{
+			m_StaticGeometry.QuerySwept(aabb, motion, filter, f);
+		}
+
+		// Gets the number of merged rectangles in the static geometry
+		inline size_t GetStaticRectangleCount() const { return m_StaticGeometry.size(); }
+
+		////////////////////////////////////////////////////////////////
+		// Contacts                                                   //
+		////////////////////////////////////////////////////////////////
+
+		// Reports contacts of a game object with the game objects that match the filter (to the listener, if any, and in the contact events)
+		//		NOTE: contacts are found through a cache of the pairs of game 
+		//		objects whose broadphase proxies overlap. Only game objects whose
+		//		proxies moved are queried for new pairs, and only pairs with a 
+		//		game object that moved are tested for contact again, so the cost
+		//		follows what moved. Enabling contacts again changes the filter 
+		//		and the listener. Contacts must not be enabled or disabled while 
+		//		game objects are updated in parallel (see WorldManager::Defer).
+		void EnableContacts(GameObject* gameObject, const CollisionFilter& filter, ContactListener* listener = NULL);
+
+		// Stops reporting contacts of a game object (ends its current contacts)
+		void DisableContacts(GameObject* gameObject);
+
+		// Updates the contact pairs, and reports the contacts that began, stayed and ended since the last update
+		//		NOTE: called by the world manager after the game objects moved.
+		//		Listeners are called as the contacts are found, and must not 
+		//		enable or disable contacts. Contacts of game objects that are 
+		//		removed end right away, and are reported with the contacts of 
+		//		the next update.
+		void UpdateContacts(GameObjectDataStore& gameObjectData);
+
+		// Gets the contacts that began, stayed and ended in the last update
+		inline const std::vector<Contact>& GetContactBeginEvents() const { return m_ContactBeginEvents; }
+		inline const std::vector<Contact>& GetContactStayEvents() const { return m_ContactStayEvents; }
+		inline const std::vector<Contact>& GetContactEndEvents() const { return m_ContactEndEvents; }
+
+		// Gets the number of cached contact pairs
+		inline size_t GetContactPairCount() const { return m_ContactPairs.size(); }
+
 		////////////////////////////////////////////////////////////////
 		// 2D intersection testing                                    //
 		////////////////////////////////////////////////////////////////
@@ -538,6 +756,55 @@ namespace Engine{
 			return IsIntersecting<valuetype>(c, aabb);
 		}
 
+		// Finds the point, normal and path progression where a moving circle enters an AABB
+		template<typename valuetype>
+		static bool IsIntersecting(const circle<valuetype>& c, const aabb2D<valuetype>& aabb, const vector2D<valuetype>& motion_c, vector2D<valuetype>& out_EnterPosition, vector2D<valuetype>& out_EnterNormal, valuetype& out_EnterProgression)
+		{
+			// Convert the circle-aabb raycast to a ray-aabb raycast against the AABB grown by the radius
+			vector2D<valuetype> l_start(c.p());
+			vector2D<valuetype> l_end(l_start + motion_c);
+			ray2D<valuetype> l_ray(l_start, l_end);
+			vector2D<valuetype> l_combinedExtent(aabb.extent() + vector2D<valuetype>(c.r(), c.r()));
+			aabb2D<valuetype> l_rect(aabb.center() - l_combinedExtent, aabb.center() + l_combinedExtent);
+			if (!IsIntersecting(l_ray, l_rect, out_EnterPosition, out_EnterNormal, out_EnterProgression)) { return false; }
+
+			// The ray enters the grown AABB next to a corner, where it is rounded by a circle around the corner
+			bool outsideX = out_EnterPosition.x() < aabb.x1() || out_EnterPosition.x() > aabb.x2();
+			bool outsideY = out_EnterPosition.y() < aabb.y1() || out_EnterPosition.y() > aabb.y2();
+			if (outsideX && outsideY)
+			{
+				vector2D<valuetype> l_corner(
+					(out_EnterPosition.x() < aabb.x1()) ? aabb.x1() : aabb.x2(),
+					(out_EnterPosition.y() < aabb.y1()) ? aabb.y1() : aabb.y2()
+					);
+				return IsIntersecting(l_ray, circle<valuetype>(l_corner, c.r()), out_EnterPosition, out_EnterNormal, out_EnterProgression);
+			}
+
+			return true;
+		}
+
+		// Finds the point, normal and path progression where a moving AABB enters a circle
+		template<typename valuetype>
+		static bool IsIntersecting(const aabb2D<valuetype>& aabb, const circle<valuetype>& c, const vector2D<valuetype>& motion_aabb, vector2D<valuetype>& out_EnterPosition, vector2D<valuetype>& out_EnterNormal, valuetype& out_EnterProgression)
+		{
+			// Move the circle towards the AABB instead (which enters at the same progression, with the opposite normal)
+			if (!IsIntersecting(c, aabb, -motion_aabb, out_EnterPosition, out_EnterNormal, out_EnterProgression)) { return false; }
+			out_EnterPosition = aabb.center() + (motion_aabb * out_EnterProgression);
+			out_EnterNormal = -out_EnterNormal;
+			return true;
+		}
+
+		////////////////////////////////////////////////////// Colliders
+
+		// Finds the point, normal and path progression where a moving collider enters another collider (both placed in the world AABBs of their game objects)
+		//		NOTE: the test is looked up in a table of the swept tests above by 
+		//		the shapes of both colliders, so no virtual calls are made and 
+		//		every pair of shapes is tested exactly.
+		static inline bool IsIntersecting(const Collider& c1, const aabb2Df& aabb1, const Collider& c2, const aabb2Df& aabb2, const f2& motion_c1, f2& out_EnterPosition, f2& out_EnterNormal, float& out_EnterProgression)
+		{
+			return s_ColliderTests[size_t(c1.m_Shape)][size_t(c2.m_Shape)](c1, aabb1, c2, aabb2, motion_c1, out_EnterPosition, out_EnterNormal, out_EnterProgression);
+		}
+
 		////////////////////////////////////////////////////////////////
 		// 3D intersection testing                                    //
 		////////////////////////////////////////////////////////////////
@@ -1021,6 +1288,183 @@ namespace Engine{
 			return IsIntersecting<valuetype>(s, aabb);
 		}
 
+	private:
+
+		// Swept test between two colliders
+		typedef bool(*ColliderTest)(const Collider& c1, const aabb2Df& aabb1, const Collider& c2, const aabb2Df& aabb2, const f2& motion_c1, f2& out_EnterPosition, f2& out_EnterNormal, float& out_EnterProgression);
+
+		// Swept tests between all pairs of shapes of colliders (indexed by the shape of the moving collider, then the other collider)
+		static const ColliderTest s_ColliderTests[Collider::s_ShapeCount][Collider::s_ShapeCount];
+
+		// Finds the point, normal and path progression where a moving collider enters another collider with the specified shapes
+		template<Collider::Shape shape1, Collider::Shape shape2>
+		static bool IsIntersectingColliders(const Collider& c1, const aabb2Df& aabb1, const Collider& c2, const aabb2Df& aabb2, const f2& motion_c1, f2& out_EnterPosition, f2& out_EnterNormal, float& out_EnterProgression)
+		{
+			return IsIntersecting(ColliderShape<shape1>::Place(c1, aabb1), ColliderShape<shape2>::Place(c2, aabb2), motion_c1, out_EnterPosition, out_EnterNormal, out_EnterProgression);
+		}
+
+		// Margin by which the AABBs in the tree are enlarged (game objects that move less do not change the tree)
+		static const float s_TreeMargin;
+
+		// Margin by which the AABBs in the grid are enlarged (kept small, so game objects span few cells)
+		static const float s_GridMargin;
+
+		// Type of the broadphase
+		BroadphaseType m_BroadphaseType;
+
+		// Dynamic AABB tree holding the fat AABBs of all game objects in the world (when selected)
+		DynamicAABBTree m_Tree;
+
+		// Uniform grid holding the fat AABBs of all game objects in the world (when selected)
+		SpatialHashGrid m_Grid;
+
+		// Margin by which the positions in the position tree are enlarged
+		static const float s_PositionMargin;
+
+		// Dynamic AABB tree holding the positions of all game objects in the world (for nearest neighbour queries)
+		DynamicAABBTree m_Positions;
+
+		// Dynamic AABB tree holding the AABBs of the static game objects (without margin, as static game objects do not move)
+		DynamicAABBTree m_StaticProxies;
+
+		// Merged rectangles of the static game objects, which moving game objects collide with
+		StaticGeometry m_StaticGeometry;
+
+		// Solid AABBs of the static game objects (collected when the static geometry is rebuilt)
+		std::vector<StaticGeometry::Solid> m_StaticSolids;
+
+		// Whether a static game object was added, moved or removed since the static geometry was built
+		bool m_StaticGeometryDirty;
+
+		// Calls a function on all game objects in the selected broadphase that match the filter and whose AABB overlaps with the specified area
+		template<typename function>
+		inline void QueryBroadphase(const aabb2Df& aabb, const CollisionFilter& filter, function f) const
+		{
+			switch (m_BroadphaseType)
+			{
+			case BroadphaseType::TREE:
+				m_Tree.Query(aabb, [&](GameObject* gameObject, ProxyID proxy)
+				{
+					if (filter.Matches(m_Tree.tag(proxy), m_Tree.category(proxy)) && IsIntersecting(gameObject->aabb2D_world_uncached(), aabb)) { f(gameObject); }
+				});
+				break;
+			case BroadphaseType::GRID:
+				m_Grid.Query(aabb, [&](GameObject* gameObject, ProxyID proxy)
+				{
+					if (filter.Matches(m_Grid.tag(proxy), m_Grid.category(proxy)) && IsIntersecting(gameObject->aabb2D_world_uncached(), aabb)) { f(gameObject); }
+				});
+				break;
+			}
+		}
+
+		// Moves the broadphase proxy of a game object to the specified AABB (returns whether the proxy had to be moved)
+		inline bool MoveBroadphaseProxy(GameObject* gameObject, const aabb2Df& aabb)
+		{
+			if (gameObject->m_Static) { m_StaticGeometryDirty = true; return m_StaticProxies.MoveProxy(gameObject->m_Proxy, aabb); }
+			return (m_BroadphaseType == BroadphaseType::TREE) ? m_Tree.MoveProxy(gameObject->m_Proxy, aabb) : m_Grid.MoveProxy(gameObject->m_Proxy, aabb);
+		}
+
+		// Moves the proxies of a game object to the specified AABB in the selected broadphase, and to the specified position in the position tree
+		inline void MoveProxy(GameObject* gameObject, const aabb2Df& aabb, const f2& position)
+		{
+			bool proxyMoved = MoveBroadphaseProxy(gameObject, aabb);
+			m_Positions.MoveProxy(gameObject->m_PositionProxy, aabb2Df(position.x(), position.x(), position.y(), position.y()));
+			MarkContactMoved(gameObject, proxyMoved);
+		}
+
+		// Game object that reports contacts
+		struct ContactSensor
+		{
+			GameObject* m_GameObject;
+			CollisionFilter m_Filter;
+			ContactListener* m_Listener;
+		};
+
+		// Pair of game objects whose broadphase proxies overlap (ordered by handle), and whether their AABBs are in contact
+		struct ContactPair
+		{
+			GameObject* m_A;
+			GameObject* m_B;
+			bool m_Touching;
+		};
+
+		// Key of a contact pair (the addresses of its game objects, ordered by handle)
+		struct ContactPairKey
+		{
+			GameObject* m_A;
+			GameObject* m_B;
+
+			inline bool operator==(const ContactPairKey& other) const { return m_A == other.m_A && m_B == other.m_B; }
+		};
+
+		// Hashes contact pair keys
+		struct ContactPairKeyHash
+		{
+			inline size_t operator()(const ContactPairKey& key) const { return std::hash<GameObject*>()(key.m_A) ^ (std::hash<GameObject*>()(key.m_B) * 31); }
+		};
+
+		// Kinds of contact events
+		enum class ContactEvent { BEGIN, STAY, END };
+
+		// Contact event whose listeners are called once the contacts are updated
+		struct ContactReport
+		{
+			ContactEvent m_Type;
+			GameObject* m_A;
+			GameObject* m_B;
+		};
+
+		// Game objects that report contacts
+		std::vector<ContactSensor> m_ContactSensors;
+
+		// Pairs of game objects whose broadphase proxies overlap, of which at least one reports contacts with the other (in the order they were found)
+		std::vector<ContactPair> m_ContactPairs;
+		std::unordered_set<ContactPairKey, ContactPairKeyHash> m_ContactPairKeys;
+
+		// Game objects whose AABBs or proxies moved since the contacts were last updated
+		std::vector<GameObjectHandle> m_ContactMoved;
+
+		// Contacts that began, stayed and ended in the last update, and contacts that ended since then (by removing game objects)
+		std::vector<Contact> m_ContactBeginEvents;
+		std::vector<Contact> m_ContactStayEvents;
+		std::vector<Contact> m_ContactEndEvents;
+		std::vector<Contact> m_PendingContactEndEvents;
+
+		// Whether the contacts are being updated (listeners are called afterwards, so the game objects they add or move are tracked for the next update)
+		bool m_UpdatingContacts;
+
+		// Contact events found while updating the contacts, whose listeners have not been called yet
+		std::vector<ContactReport> m_ContactReports;
+
+		// Remembers that the AABB (and possibly the proxy) of a game object moved since the contacts were last updated
+		inline void MarkContactMoved(GameObject* gameObject, bool proxyMoved)
+		{
+			if (m_ContactSensors.empty()) { return; }
+			if (!gameObject->HasFlag(FLAG_CONTACT_MOVED)) { m_ContactMoved.push_back(gameObject->handle()); gameObject->SetFlag(FLAG_CONTACT_MOVED, true); }
+			if (proxyMoved) { gameObject->SetFlag(FLAG_PROXY_MOVED, true); }
+		}
+
+		// Checks whether either game object of a pair reports contacts with the other
+		inline bool IsContactPair(const GameObject* a, const GameObject* b) const
+		{
+			return (a->m_Sensing && m_ContactSensors[a->m_SensorIndex].m_Filter.Matches(b->type(), b->m_CollisionCategory)) || (b->m_Sensing && m_ContactSensors[b->m_SensorIndex].m_Filter.Matches(a->type(), a->m_CollisionCategory));
+		}
+
+		// Adds a pair of game objects to the contact pairs (if it is not cached already)
+		void AddContactPair(GameObject* a, GameObject* b);
+
+		// Removes a contact pair (moves the last pair into its place, and ends its contact)
+		void RemoveContactPair(size_t index, std::vector<Contact>& out_EndEvents);
+
+		// Removes the contact pairs of a game object (all of them, or only the ones that are no longer reported)
+		void RemoveContactPairs(GameObject* gameObject, bool unreportedOnly, std::vector<Contact>& out_EndEvents);
+
+		// Reports a contact event of a pair (to the listeners of its game objects, and in the specified events)
+		void ReportContact(ContactEvent type, const ContactPair& pair, std::vector<Contact>& out_Events);
+
+		// Calls the listeners of the game objects of a contact event
+		void CallContactListeners(ContactEvent type, GameObject* a, GameObject* b);
+
 	};
 }
 
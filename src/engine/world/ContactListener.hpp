@@ -0,0 +1,33 @@
+#pragma once
+#ifndef ENGINE_WORLD_CONTACTLISTENER_H
+#define ENGINE_WORLD_CONTACTLISTENER_H
+
+#include "GameObjectHandle.hpp" // For identifying the game objects of a contact
+
+namespace Engine{
+
+	class GameObject;
+
+	// Contact between the AABBs of two game objects
+	//		NOTE: contacts are reported by handle, so contacts of game objects
+	//		that were removed in the meantime do not resolve.
+	struct Contact
+	{
+		GameObjectHandle m_A;
+		GameObjectHandle m_B;
+	};
+
+	// Interface for objects that listen to contact events of a game object
+	class ContactListener{
+
+	public:
+
+		virtual ~ContactListener() { };
+		virtual void ProcessContactBeginEvent(GameObject* gameObject, GameObject* other) { };
+		virtual void ProcessContactStayEvent(GameObject* gameObject, GameObject* other) { };
+		virtual void ProcessContactEndEvent(GameObject* gameObject, GameObject* other) { };
+
+	};
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include "DynamicAABBTree.hpp"
+
+// Constructor (with the margin by which AABBs are enlarged)
+Engine::DynamicAABBTree::DynamicAABBTree(float margin)
+	: m_Root(PROXY_INVALID), m_FreeList(PROXY_INVALID), m_ProxyCount(0), m_Margin(margin)
+{
+
+}
+
+////////////////////////////////////////////////////////////////
+// Proxies                                                    //
+////////////////////////////////////////////////////////////////
+
+// Creates a proxy for a game object, with a tag and category bits for filtering queries (returns its proxy ID)
+Engine::ProxyID Engine::DynamicAABBTree::CreateProxy(const aabb2Df& aabb, GameObject* gameObject, unsigned int tag, unsigned int category)
+{
+	ProxyID proxy = AllocateNode();
+	Node& node = m_Nodes[proxy];
+	node.m_AABB = aabb2Df(aabb.x1() - m_Margin, aabb.x2() + m_Margin, aabb.y1() - m_Margin, aabb.y2() + m_Margin);
+	node.m_GameObject = gameObject;
+	node.m_Tag = tag;
+	node.m_Category = category;
+	node.m_Height = 0;
+	InsertLeaf(proxy);
+	m_ProxyCount++;
+	return proxy;
+}
+
+// Destroys a proxy
+void Engine::DynamicAABBTree::DestroyProxy(ProxyID proxy)
+{
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	m_ProxyCount--;
+}
+
+// Moves a proxy (returns whether the proxy had to be re-inserted)
+bool Engine::DynamicAABBTree::MoveProxy(ProxyID proxy, const aabb2Df& aabb)
+{
+	// Keep the proxy in place while the AABB stays inside the fat AABB
+	if (IsContaining(m_Nodes[proxy].m_AABB, aabb)) { return false; }
+
+	RemoveLeaf(proxy);
+	m_Nodes[proxy].m_AABB = aabb2Df(aabb.x1() - m_Margin, aabb.x2() + m_Margin, aabb.y1() - m_Margin, aabb.y2() + m_Margin);
+	InsertLeaf(proxy);
+	return true;
+}
+
+// Removes all proxies
+void Engine::DynamicAABBTree::Clear()
+{
+	m_Nodes.clear();
+	m_Root = PROXY_INVALID;
+	m_FreeList = PROXY_INVALID;
+	m_ProxyCount = 0;
+}
+
+////////////////////////////////////////////////////////////////
+// Nodes                                                      //
+////////////////////////////////////////////////////////////////
+
+// Takes a node from the free list (grows the node pool if needed)
+Engine::ProxyID Engine::DynamicAABBTree::AllocateNode()
+{
+	if (m_FreeList == PROXY_INVALID)
+	{
+		Node node;
+		node.m_GameObject = NULL;
+		node.m_Tag = 0;
+		node.m_Category = 0;
+		node.m_Parent = PROXY_INVALID;
+		node.m_Height = -1;
+		m_Nodes.push_back(node);
+		m_FreeList = ProxyID(m_Nodes.size() - 1);
+	}
+
+	ProxyID id = m_FreeList;
+	Node& node = m_Nodes[id];
+	m_FreeList = node.m_Parent;
+	node.m_GameObject = NULL;
+	node.m_Tag = 0;
+	node.m_Category = 0;
+	node.m_Parent = PROXY_INVALID;
+	node.m_Child1 = PROXY_INVALID;
+	node.m_Child2 = PROXY_INVALID;
+	node.m_Height = 0;
+	return id;
+}
+
+// Returns a node to the free list
+void Engine::DynamicAABBTree::FreeNode(ProxyID node)
+{
+	m_Nodes[node].m_Parent = m_FreeList;
+	m_Nodes[node].m_Height = -1;
+	m_FreeList = node;
+}
+
+// Inserts a leaf into the tree (next to the sibling that grows the tree the least)
+void Engine::DynamicAABBTree::InsertLeaf(ProxyID leaf)
+{
+	if (m_Root == PROXY_INVALID)
+	{
+		m_Root = leaf;
+		m_Nodes[leaf].m_Parent = PROXY_INVALID;
+		return;
+	}
+
+	// Descend towards the cheapest sibling (cost is the perimeter added to the tree)
+	aabb2Df leafAABB = m_Nodes[leaf].m_AABB;
+	ProxyID index = m_Root;
+	while (!m_Nodes[index].IsLeaf())
+	{
+		const Node& node = m_Nodes[index];
+		float perimeter = Perimeter(node.m_AABB);
+		float combinedPerimeter = Perimeter(Combine(node.m_AABB, leafAABB));
+
+		// Cost of pairing the leaf with this node, and the cost pushed down to the children
+		float cost = 2.0f * combinedPerimeter;
+		float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+		const Node& child1 = m_Nodes[node.m_Child1];
+		float cost1 = Perimeter(Combine(leafAABB, child1.m_AABB)) + inheritanceCost;
+		if (!child1.IsLeaf()) { cost1 -= Perimeter(child1.m_AABB); }
+
+		const Node& child2 = m_Nodes[node.m_Child2];
+		float cost2 = Perimeter(Combine(leafAABB, child2.m_AABB)) + inheritanceCost;
+		if (!child2.IsLeaf()) { cost2 -= Perimeter(child2.m_AABB); }
+
+		if (cost < cost1 && cost < cost2) { break; }
+		index = (cost1 < cost2) ? node.m_Child1 : node.m_Child2;
+	}
+	ProxyID sibling = index;
+
+	// Create a new parent for the leaf and its sibling
+	ProxyID oldParent = m_Nodes[sibling].m_Parent;
+	ProxyID newParent = AllocateNode();
+	m_Nodes[newParent].m_Parent = oldParent;
+	m_Nodes[newParent].m_AABB = Combine(leafAABB, m_Nodes[sibling].m_AABB);
+	m_Nodes[newParent].m_Height = m_Nodes[sibling].m_Height + 1;
+	m_Nodes[newParent].m_Child1 = sibling;
+	m_Nodes[newParent].m_Child2 = leaf;
+	m_Nodes[sibling].m_Parent = newParent;
+	m_Nodes[leaf].m_Parent = newParent;
+
+	if (oldParent == PROXY_INVALID) { m_Root = newParent; }
+	else if (m_Nodes[oldParent].m_Child1 == sibling) { m_Nodes[oldParent].m_Child1 = newParent; }
+	else { m_Nodes[oldParent].m_Child2 = newParent; }
+
+	Refit(m_Nodes[leaf].m_Parent);
+}
+
+// Removes a leaf from the tree
+void Engine::DynamicAABBTree::RemoveLeaf(ProxyID leaf)
+{
+	if (leaf == m_Root)
+	{
+		m_Root = PROXY_INVALID;
+		return;
+	}
+
+	// Replace the parent of the leaf by the sibling of the leaf
+	ProxyID parent = m_Nodes[leaf].m_Parent;
+	ProxyID grandParent = m_Nodes[parent].m_Parent;
+	ProxyID sibling = (m_Nodes[parent].m_Child1 == leaf) ? m_Nodes[parent].m_Child2 : m_Nodes[parent].m_Child1;
+	FreeNode(parent);
+
+	if (grandParent == PROXY_INVALID)
+	{
+		m_Root = sibling;
+		m_Nodes[sibling].m_Parent = PROXY_INVALID;
+		return;
+	}
+
+	if (m_Nodes[grandParent].m_Child1 == parent) { m_Nodes[grandParent].m_Child1 = sibling; }
+	else { m_Nodes[grandParent].m_Child2 = sibling; }
+	m_Nodes[sibling].m_Parent = grandParent;
+
+	Refit(grandParent);
+}
+
+// Refits the AABBs and heights of all ancestors of a node (balancing them on the way up)
+void Engine::DynamicAABBTree::Refit(ProxyID node)
+{
+	for (ProxyID index = node; index != PROXY_INVALID; index = m_Nodes[index].m_Parent)
+	{
+		index = Balance(index);
+
+		Node& n = m_Nodes[index];
+		const Node& child1 = m_Nodes[n.m_Child1];
+		const Node& child2 = m_Nodes[n.m_Child2];
+		n.m_Height = 1 + ((child1.m_Height > child2.m_Height) ? child1.m_Height : child2.m_Height);
+		n.m_AABB = Combine(child1.m_AABB, child2.m_AABB);
+	}
+}
+
+// Rotates the subtree at a node if it is imbalanced (returns the new root of the subtree)
+Engine::ProxyID Engine::DynamicAABBTree::Balance(ProxyID a)
+{
+	if (m_Nodes[a].IsLeaf() || m_Nodes[a].m_Height < 2) { return a; }
+
+	ProxyID b = m_Nodes[a].m_Child1;
+	ProxyID c = m_Nodes[a].m_Child2;
+	int balance = m_Nodes[c].m_Height - m_Nodes[b].m_Height;
+	if (balance >= -1 && balance <= 1) { return a; }
+
+	// Rotate the higher child up (x is the higher child, y the lower one)
+	ProxyID x = (balance > 1) ? c : b;
+	ProxyID y = (balance > 1) ? b : c;
+	ProxyID f = m_Nodes[x].m_Child1;
+	ProxyID g = m_Nodes[x].m_Child2;
+
+	// Swap a and x
+	m_Nodes[x].m_Child1 = a;
+	m_Nodes[x].m_Parent = m_Nodes[a].m_Parent;
+	m_Nodes[a].m_Parent = x;
+	if (m_Nodes[x].m_Parent == PROXY_INVALID) { m_Root = x; }
+	else if (m_Nodes[m_Nodes[x].m_Parent].m_Child1 == a) { m_Nodes[m_Nodes[x].m_Parent].m_Child1 = x; }
+	else { m_Nodes[m_Nodes[x].m_Parent].m_Child2 = x; }
+
+	// Keep the higher grandchild under x, and move the lower grandchild under a
+	ProxyID high = (m_Nodes[f].m_Height > m_Nodes[g].m_Height) ? f : g;
+	ProxyID low = (high == f) ? g : f;
+	m_Nodes[x].m_Child2 = high;
+	if (balance > 1) { m_Nodes[a].m_Child2 = low; }
+	else { m_Nodes[a].m_Child1 = low; }
+	m_Nodes[low].m_Parent = a;
+
+	Node& nodeA = m_Nodes[a];
+	nodeA.m_AABB = Combine(m_Nodes[y].m_AABB, m_Nodes[low].m_AABB);
+	nodeA.m_Height = 1 + ((m_Nodes[y].m_Height > m_Nodes[low].m_Height) ? m_Nodes[y].m_Height : m_Nodes[low].m_Height);
+
+	Node& nodeX = m_Nodes[x];
+	nodeX.m_AABB = Combine(nodeA.m_AABB, m_Nodes[high].m_AABB);
+	nodeX.m_Height = 1 + ((nodeA.m_Height > m_Nodes[high].m_Height) ? nodeA.m_Height : m_Nodes[high].m_Height);
+
+	return x;
+}
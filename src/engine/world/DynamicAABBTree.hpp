@@ -0,0 +1,221 @@
+#pragma once
+#ifndef ENGINE_WORLD_DYNAMICAABBTREE_H
+#define ENGINE_WORLD_DYNAMICAABBTREE_H
+
+#include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "../common/utility/VectorTypes.hpp" // For representing query points
+
+#include <vector> // For holding the nodes of the tree
+
+namespace Engine{
+
+	class GameObject;
+
+	// Typedef for proxies in a dynamic AABB tree
+	typedef int ProxyID;
+
+	// Invalid proxy ID
+	static const ProxyID PROXY_INVALID = -1;
+
+	// Balanced bounding volume hierarchy of 2D AABBs, for querying game objects by area
+	//		NOTE: each proxy stores a fat AABB, which is the AABB of the game object
+	//		enlarged by the margin of the tree. Moving a proxy only changes the
+	//		tree when the AABB of the game object leaves its fat AABB, so game
+	//		objects that move a little each frame rarely cause re-insertions.
+	//		Queries return all proxies whose fat AABB overlaps with the query area.
+	class DynamicAABBTree
+	{
+
+	public:
+
+		// Constructor (with the margin by which AABBs are enlarged)
+		DynamicAABBTree(float margin = 0.0f);
+
+		// Creates a proxy for a game object, with a tag and category bits for filtering queries (returns its proxy ID)
+		ProxyID CreateProxy(const aabb2Df& aabb, GameObject* gameObject, unsigned int tag = 0, unsigned int category = 0);
+
+		// Destroys a proxy
+		void DestroyProxy(ProxyID proxy);
+
+		// Moves a proxy (returns whether the proxy had to be re-inserted)
+		bool MoveProxy(ProxyID proxy, const aabb2Df& aabb);
+
+		// Removes all proxies
+		void Clear();
+
+		// Gets the fat AABB of a proxy
+		inline const aabb2Df& fatAABB(ProxyID proxy) const { return m_Nodes[proxy].m_AABB; }
+
+		// Gets the game object of a proxy
+		inline GameObject* gameObject(ProxyID proxy) const { return m_Nodes[proxy].m_GameObject; }
+
+		// Gets the tag of a proxy
+		inline unsigned int tag(ProxyID proxy) const { return m_Nodes[proxy].m_Tag; }
+
+		// Gets the category bits of a proxy
+		inline unsigned int category(ProxyID proxy) const { return m_Nodes[proxy].m_Category; }
+
+		// Changes the category bits of a proxy
+		inline void SetCategory(ProxyID proxy, unsigned int category) { m_Nodes[proxy].m_Category = category; }
+
+		// Gets the number of proxies in the tree
+		inline size_t size() const { return m_ProxyCount; }
+
+		// Gets the height of the tree (0 for an empty tree or a single proxy)
+		inline int height() const { return (m_Root == PROXY_INVALID) ? 0 : m_Nodes[m_Root].m_Height; }
+
+		// Gets the margin by which AABBs are enlarged
+		inline float margin() const { return m_Margin; }
+
+		// Calls a function on all game objects whose fat AABB overlaps with the specified area
+		//		NOTE: the function is called as f(gameObject, proxy). Queries do
+		//		not allocate memory and do not modify the tree, so multiple
+		//		threads can query the tree as long as no proxies are changed.
+		template<typename function>
+		inline void Query(const aabb2Df& aabb, function f) const
+		{
+			if (m_Root == PROXY_INVALID) { return; }
+
+			ProxyID stack[s_MaxQueryDepth];
+			size_t stackSize = 0;
+			stack[stackSize++] = m_Root;
+			while (stackSize > 0)
+			{
+				ProxyID id = stack[--stackSize];
+				const Node& node = m_Nodes[id];
+				if (!IsOverlapping(node.m_AABB, aabb)) { continue; }
+				if (node.IsLeaf()) { f(node.m_GameObject, id); continue; }
+				stack[stackSize++] = node.m_Child1;
+				stack[stackSize++] = node.m_Child2;
+			}
+		}
+
+		// Calls a function on all game objects whose fat AABB lies within a squared distance from a point (nearest subtrees first)
+		//		NOTE: the function is called as f(gameObject, proxy), and may 
+		//		shrink the squared distance while the query runs (e.g. once k
+		//		nearest game objects are found), which prunes the rest of the
+		//		query. Like Query(), this does not allocate or modify the tree.
+		template<typename function>
+		inline void QueryNearest(const f2& point, float& maxDistanceSquared, function f) const
+		{
+			if (m_Root == PROXY_INVALID) { return; }
+
+			ProxyID stack[s_MaxQueryDepth];
+			size_t stackSize = 0;
+			stack[stackSize++] = m_Root;
+			while (stackSize > 0)
+			{
+				ProxyID id = stack[--stackSize];
+				const Node& node = m_Nodes[id];
+				if (DistanceSquared(node.m_AABB, point) > maxDistanceSquared) { continue; }
+				if (node.IsLeaf()) { f(node.m_GameObject, id); continue; }
+
+				// Push the farther child first, so the nearer child is visited first
+				bool firstIsNearer = DistanceSquared(m_Nodes[node.m_Child1].m_AABB, point) <= DistanceSquared(m_Nodes[node.m_Child2].m_AABB, point);
+				stack[stackSize++] = firstIsNearer ? node.m_Child2 : node.m_Child1;
+				stack[stackSize++] = firstIsNearer ? node.m_Child1 : node.m_Child2;
+			}
+		}
+
+		// Calls a function on all proxies in the tree
+		//		NOTE: the function is called as f(gameObject, proxy).
+		template<typename function>
+		inline void ForEachProxy(function f) const
+		{
+			for (size_t i = 0; i < m_Nodes.size(); i++)
+			{
+				if (m_Nodes[i].m_Height == 0) { f(m_Nodes[i].m_GameObject, ProxyID(i)); }
+			}
+		}
+
+	private:
+
+		// Maximum number of nodes on the stack of a query (balancing keeps the height of the tree far below this)
+		static const size_t s_MaxQueryDepth = 256;
+
+		// Node of the tree (leaves hold proxies)
+		struct Node
+		{
+			aabb2Df m_AABB;
+			GameObject* m_GameObject;
+			unsigned int m_Tag;
+			unsigned int m_Category;
+			ProxyID m_Parent;	// Parent node, or next free node for nodes in the free list
+			ProxyID m_Child1;
+			ProxyID m_Child2;
+			int m_Height;		// 0 for leaves, -1 for free nodes
+
+			inline bool IsLeaf() const { return m_Child1 == PROXY_INVALID; }
+		};
+
+		// Nodes of the tree
+		std::vector<Node> m_Nodes;
+
+		// Root node
+		ProxyID m_Root;
+
+		// First node of the free list
+		ProxyID m_FreeList;
+
+		// Number of proxies in the tree
+		size_t m_ProxyCount;
+
+		// Margin by which AABBs are enlarged
+		float m_Margin;
+
+		// Takes a node from the free list (grows the node pool if needed)
+		ProxyID AllocateNode();
+
+		// Returns a node to the free list
+		void FreeNode(ProxyID node);
+
+		// Inserts a leaf into the tree (next to the sibling that grows the tree the least)
+		void InsertLeaf(ProxyID leaf);
+
+		// Removes a leaf from the tree
+		void RemoveLeaf(ProxyID leaf);
+
+		// Rotates the subtree at a node if it is imbalanced (returns the new root of the subtree)
+		ProxyID Balance(ProxyID node);
+
+		// Refits the AABBs and heights of all ancestors of a node (balancing them on the way up)
+		void Refit(ProxyID node);
+
+		// Checks whether two AABBs overlap
+		static inline bool IsOverlapping(const aabb2Df& a, const aabb2Df& b)
+		{
+			return a.x1() <= b.x2() && b.x1() <= a.x2() && a.y1() <= b.y2() && b.y1() <= a.y2();
+		}
+
+		// Checks whether an AABB lies completely inside another AABB
+		static inline bool IsContaining(const aabb2Df& outer, const aabb2Df& inner)
+		{
+			return outer.x1() <= inner.x1() && outer.y1() <= inner.y1() && inner.x2() <= outer.x2() && inner.y2() <= outer.y2();
+		}
+
+		// Gets the squared distance from a point to an AABB (0 for points inside the AABB)
+		static inline float DistanceSquared(const aabb2Df& a, const f2& p)
+		{
+			float dx = (p.x() < a.x1()) ? a.x1() - p.x() : ((p.x() > a.x2()) ? p.x() - a.x2() : 0.0f);
+			float dy = (p.y() < a.y1()) ? a.y1() - p.y() : ((p.y() > a.y2()) ? p.y() - a.y2() : 0.0f);
+			return dx * dx + dy * dy;
+		}
+
+		// Gets the smallest AABB containing two AABBs
+		static inline aabb2Df Combine(const aabb2Df& a, const aabb2Df& b)
+		{
+			return aabb2Df(
+				(a.x1() < b.x1()) ? a.x1() : b.x1(), (a.x2() > b.x2()) ? a.x2() : b.x2(),
+				(a.y1() < b.y1()) ? a.y1() : b.y1(), (a.y2() > b.y2()) ? a.y2() : b.y2());
+		}
+
+		// Gets the perimeter of an AABB (used as the cost of a node)
+		static inline float Perimeter(const aabb2Df& a)
+		{
+			return 2.0f * ((a.x2() - a.x1()) + (a.y2() - a.y1()));
+		}
+
+	};
+}
+
+#endif
@@ -1,12 +1,25 @@
 #include "GameObject.hpp"
 
+#include "WorldManager.hpp" // For freeing the transform, motion and AABB data of the game object
+#include "CollisionManager.hpp" // For updating the collision categories in the broadphase
+
 // Constructor (with transform and aabb)
 Engine::GameObject::GameObject(const transform3D& transform, const aabb3Df& aabb)
-	: m_GUID(s_GUIDCounter++)
-	, m_Transform(transform)
-	, m_AABB(aabb)
+	: m_GUID(GameObjectHandle()), m_Pool(NULL), m_Data(NULL), m_DataIndex(0), m_TypeIndex(0), m_Sleeping(false), m_UpdateInterval(1), m_UpdateBucket(0), m_UpdateIndex(0), m_Moving(false), m_MoverIndex(0), m_Proxy(PROXY_INVALID), m_PositionProxy(PROXY_INVALID), m_Static(false), m_Sensing(false), m_SensorIndex(0), m_ContactPairs(0), m_CollisionCategory(0x00000001), m_CollisionMask(0xFFFFFFFF), m_Collider(Collider::AABB()), m_Sequence(0), m_DrawFrame(0), m_DrawIndex(0)
 {
+	// Keep the data in the game object until it is added to the world
+	m_Detached.m_Flags = FLAG_AABB_DIRTY;
+	m_Detached.m_Translation = transform.t();
+	m_Detached.m_Rotation = transform.r();
+	m_Detached.m_Scale = transform.s();
+	m_Detached.m_Velocity = f3(0.0f);
+	m_Detached.m_AABBLocal = aabb;
+}
 
+// Destructor
+Engine::GameObject::~GameObject()
+{
+	if (m_Data != NULL) { WorldManager::GetInstance().GetGameObjectData().Free(this); }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -14,24 +27,21 @@ Engine::GameObject::GameObject(const transform3D& transform, const aabb3Df& aabb
 ////////////////////////////////////////////////////////////////
 
 // Gets the globally unique ID of the game object
-const Engine::GameObjectGUID& Engine::GameObject::guid() const 
-{ 
-	return m_GUID; 
+const Engine::GameObjectGUID& Engine::GameObject::guid() const
+{
+	return m_GUID;
 }
 
-// Incrementing GUID counter
-Engine::GameObjectGUID Engine::GameObject::s_GUIDCounter = 0;
-
-////////////////////////////////////////////////////////////////
-// Transform and motion			                              //
-////////////////////////////////////////////////////////////////
+// Gets the handle of the game object
+Engine::GameObjectHandle Engine::GameObject::handle() const
+{
+	return GameObjectHandle(m_GUID);
+}
 
-// Calculates the AABB in world coordinates
-void Engine::GameObject::CalculateAABBs()
+// Sets the collision categories of the game object
+void Engine::GameObject::collisionCategory(unsigned int categories)
 {
-	m_Transform2D = (transform2D)m_Transform;
-	m_AABBWorld = (m_AABB * m_Transform.s()) + m_Transform.t();
-	m_AABB2D = (aabb2Df)m_AABB;
-	m_AABB2DWorld = (aabb2Df)m_AABBWorld;
-	m_TransformIsDirty = false;
-}
\ No newline at end of file
+	if (m_CollisionCategory == categories) { return; }
+	m_CollisionCategory = categories;
+	if (m_Proxy != PROXY_INVALID) { CollisionManager::GetInstance().UpdateProxyCategory(this); }
+}
@@ -5,15 +5,18 @@
 #include "../common/utility/GameTime.hpp" // For representing timing information on the game loop
 #include "../common/utility/TransformTypes.hpp" // For representing the transform of the GameObject
 #include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "GameObjectData.hpp" // For accessing the transform, motion and AABB data of the game object
+#include "GameObjectHandle.hpp" // For identifying game objects
+#include "DynamicAABBTree.hpp" // For referring to the proxy of the game object in the broadphase
+#include "Collider.hpp" // For representing the shape of the game object in collision-aware movement
 
 namespace Engine{
 
-	// Typedef for game object globally unique IDs
-	typedef unsigned long long GameObjectGUID;
-
 	// Typedef for game object types
 	typedef unsigned int GameObjectType;
 
+	class GameObjectPoolBase;
+
 	class GameObject{
 
 	public:
@@ -21,6 +24,9 @@ namespace Engine{
 		// Constructor 
 		GameObject(const transform3D& transform = transform3D(), const aabb3Df& aabb = aabb3Df());
 
+		// Destructor
+		virtual ~GameObject();
+
 		////////////////////////////////////////////////////////////////
 		// Game loop functionality                                    //
 		////////////////////////////////////////////////////////////////
@@ -37,25 +43,75 @@ namespace Engine{
 		// Draws the game object
 		virtual void Draw(const GameTime& gameTime) { };
 
+		// Checks whether the game object can be updated in parallel with other game objects (override to opt in to parallel updates)
+		//		NOTE: thread-safe game objects only write their own state in Update(), 
+		//		and use WorldManager::Defer() for writing to other game objects. Game 
+		//		objects that read the state of other game objects which move during 
+		//		the same update (e.g. by moving with Move2D) should not opt in.
+		virtual bool IsThreadSafe() const { return false; }
+
+		// Checks whether the game object is solid level geometry that does not move (override to bake it into the static geometry)
+		//		NOTE: static game objects are merged with adjacent static game 
+		//		objects into the static geometry of the collision manager, which
+		//		moving game objects collide with instead of the separate game 
+		//		objects. Checked once when the game object is added to the world.
+		virtual bool IsStatic() const { return false; }
+
 		////////////////////////////////////////////////////////////////
 		// Game object properties		                              //
 		////////////////////////////////////////////////////////////////
 
 	private:
 
-		// Globally unique ID of the game object
-		const GameObjectGUID m_GUID;
+		// Globally unique ID of the game object (packed handle, assigned by the game object data store when the game object is added to the world)
+		GameObjectGUID m_GUID;
+
+		friend class GameObjectPoolBase;
 
-		// Incrementing GUID counter
-		static GameObjectGUID s_GUIDCounter;
+		// Pool holding the game object (NULL for game objects allocated with new)
+		GameObjectPoolBase* m_Pool;
 
 	public:
 
 		// Gets the globally unique ID of the game object
 		const GameObjectGUID& guid() const;
 
+		// Gets the handle of the game object (invalid until the game object is added to the world)
+		GameObjectHandle handle() const;
+
 		// Gets the type of the game object
 		virtual GameObjectType type() const = 0;
+
+		// Checks whether the game object is sleeping (sleeping game objects are not updated until woken up)
+		inline bool IsSleeping() const { return m_Sleeping; }
+
+		// Gets the number of frames between updates of the game object
+		inline unsigned int updateInterval() const { return m_UpdateInterval; }
+
+		// Gets the collision categories of the game object (matched by the collision masks of other game objects)
+		inline unsigned int collisionCategory() const { return m_CollisionCategory; }
+
+		// Sets the collision categories of the game object
+		//		NOTE: the categories are stored in the broadphase, so they must 
+		//		not be changed while game objects are updated in parallel (see 
+		//		WorldManager::Defer).
+		void collisionCategory(unsigned int categories);
+
+		// Gets the collision categories the game object collides with
+		inline unsigned int collisionMask() const { return m_CollisionMask; }
+
+		// Sets the collision categories the game object collides with
+		inline void collisionMask(unsigned int categories) { m_CollisionMask = categories; }
+
+		// Gets the shape of the game object in collision-aware movement (the world AABB by default)
+		inline const Collider& collider() const { return m_Collider; }
+
+		// Sets the shape of the game object in collision-aware movement
+		//		NOTE: static game objects always collide as their AABB, as they
+		//		are merged into the rectangles of the static geometry.
+		inline void collider(const Collider& collider) { m_Collider = collider; }
+
+	public:
 		
 		////////////////////////////////////////////////////////////////
 		// Transform and motion			                              //
@@ -63,81 +119,140 @@ namespace Engine{
 
 	private:
 
-		// Dirty bit for the transform
-		bool m_TransformIsDirty = true;
+		friend class GameObjectDataStore;
+		friend class WorldManager;
+		friend class CollisionManager;
+
+		// Block holding the transform, motion and AABB data of the game object (owned by the WorldManager, NULL until the game object is added to the world)
+		GameObjectDataBlock* m_Data;
+
+		// Slot of the game object within its data block
+		size_t m_DataIndex;
+
+		// Transform, motion and AABB data of the game object until it is added to the world
+		mutable GameObjectDetachedData m_Detached;
+
+		// Position of the game object in the by-type index of the WorldManager
+		size_t m_TypeIndex;
+
+		// Whether the game object is sleeping (changed by the WorldManager in between updates)
+		bool m_Sleeping;
+
+		// Number of frames between updates of the game object (changed by the WorldManager in between updates)
+		unsigned int m_UpdateInterval;
 
-		// 3D Transform of the game object
-		transform3D m_Transform;
+		// Position of the game object in the update tiers of the WorldManager (bucket of its tier, and index within the bucket)
+		unsigned int m_UpdateBucket;
+		size_t m_UpdateIndex;
 
-		// 2D Transform of the game object
-		transform2D m_Transform2D;
+		// Whether the game object is moved every frame by the WorldManager, and its position in the movers of the WorldManager
+		bool m_Moving;
+		size_t m_MoverIndex;
 
-		// 3D AABB of the game object in local coordinates
-		aabb3Df m_AABB;
+		// Proxies of the game object in the broadphase (or the static proxies) and in the position tree of the CollisionManager
+		ProxyID m_Proxy;
+		ProxyID m_PositionProxy;
 
-		// 2D AABB of the game object in local coordinates
-		aabb2Df m_AABB2D;
+		// Whether the proxy of the game object is held by the static proxies of the CollisionManager
+		bool m_Static;
 
-		// 3D AABB of the game object in world coordinates
-		aabb3Df m_AABBWorld;
+		// Whether the game object reports contacts, its position in the contact sensors of the CollisionManager, and its number of cached contact pairs
+		bool m_Sensing;
+		size_t m_SensorIndex;
+		unsigned int m_ContactPairs;
 
-		// 2D AABB of the game object in world coordinates
-		aabb2Df m_AABB2DWorld;
+		// Collision categories of the game object (stored in its proxies), and the collision categories it collides with
+		unsigned int m_CollisionCategory;
+		unsigned int m_CollisionMask;
 
-		// Calculates the AABB in world coordinates
-		void CalculateAABBs();
+		// Shape of the game object in collision-aware movement
+		Collider m_Collider;
 
-		// Velocity vector of the game object
-		f3 m_Velocity;
+		// Order in which the game object was added to the world (breaks ties in the draw order)
+		unsigned long long m_Sequence;
+
+		// Last frame in which the game object was visible, and its position in the draw list of that frame
+		unsigned long long m_DrawFrame;
+		size_t m_DrawIndex;
+
+		// Gets the data of the game object (in its data block once it is added to the world, and in the detached data before)
+		inline GameObjectFlags& dataFlags() const { return (m_Data != NULL) ? m_Data->m_Flags[m_DataIndex] : m_Detached.m_Flags; }
+		inline f3& dataTranslation() const { return (m_Data != NULL) ? m_Data->m_Translation[m_DataIndex] : m_Detached.m_Translation; }
+		inline f3& dataRotation() const { return (m_Data != NULL) ? m_Data->m_Rotation[m_DataIndex] : m_Detached.m_Rotation; }
+		inline f3& dataScale() const { return (m_Data != NULL) ? m_Data->m_Scale[m_DataIndex] : m_Detached.m_Scale; }
+		inline f3& dataVelocity() const { return (m_Data != NULL) ? m_Data->m_Velocity[m_DataIndex] : m_Detached.m_Velocity; }
+		inline aabb3Df& dataAABBLocal() const { return (m_Data != NULL) ? m_Data->m_AABBLocal[m_DataIndex] : m_Detached.m_AABBLocal; }
+		inline aabb3Df& dataAABBWorld() const { return (m_Data != NULL) ? m_Data->m_AABBWorld[m_DataIndex] : m_Detached.m_AABBWorld; }
+		inline aabb2Df& dataAABB2DWorld() const { return (m_Data != NULL) ? m_Data->m_AABB2DWorld[m_DataIndex] : m_Detached.m_AABB2DWorld; }
+
+		// Marks the world AABBs as dirty
+		inline void MarkTransformDirty() { dataFlags() |= FLAG_AABB_DIRTY; }
+
+		// Recalculates the world AABBs if the transform has changed
+		inline void CleanTransform()
+		{
+			if ((dataFlags() & FLAG_AABB_DIRTY) == 0) { return; }
+			if (m_Data != NULL) { m_Data->CalculateAABBs(m_DataIndex); }
+			else { m_Detached.CalculateAABBs(); }
+		}
+
+		// Sets or clears a flag of the game object
+		inline void SetFlag(GameObjectFlags flag, bool set) { if (set) { dataFlags() |= flag; } else { dataFlags() &= ~flag; } }
+
+		// Checks whether a flag of the game object is set
+		inline bool HasFlag(GameObjectFlags flag) const { return (dataFlags() & flag) != 0; }
 
 	public:
 
 		// 3D transform getters
-		inline const transform3D& tf() const { return m_Transform; }
-		inline const f3& t() const { return m_Transform.t(); }
-		inline const f3& r() const { return m_Transform.r(); }
-		inline const f3& s() const { return m_Transform.s(); }
-		inline transform3D& tf() { m_TransformIsDirty = true; return m_Transform; }
-		inline f3& t() { m_TransformIsDirty = true; return m_Transform.t(); }
-		inline f3& r() { m_TransformIsDirty = true; return m_Transform.r(); }
-		inline f3& s() { m_TransformIsDirty = true; return m_Transform.s(); }
+		inline transform3D tf() const { return transform3D(t(), r(), s()); }
+		inline const f3& t() const { return dataTranslation(); }
+		inline const f3& r() const { return dataRotation(); }
+		inline const f3& s() const { return dataScale(); }
+		inline f3& t() { MarkTransformDirty(); return dataTranslation(); }
+		inline f3& r() { MarkTransformDirty(); return dataRotation(); }
+		inline f3& s() { MarkTransformDirty(); return dataScale(); }
 
 		// 3D transform setters
-		inline void tf(const transform3D& transform) { m_TransformIsDirty = true; m_Transform = transform; }
-		inline void t(const f3& t) { m_TransformIsDirty = true; m_Transform.t(t); }
-		inline void r(const f3& r) { m_TransformIsDirty = true; m_Transform.r(r); }
-		inline void s(const f3& s) { m_TransformIsDirty = true; m_Transform.s(s); }
+		inline void tf(const transform3D& transform) { t(transform.t()); r(transform.r()); s(transform.s()); }
+		inline void t(const f3& t) { MarkTransformDirty(); dataTranslation() = t; }
+		inline void r(const f3& r) { MarkTransformDirty(); dataRotation() = r; }
+		inline void s(const f3& s) { MarkTransformDirty(); dataScale() = s; }
 
 		// 2D transform getters
-		inline const transform2D& tf2D() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_Transform2D; }
-		inline const f2& t2D() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_Transform2D.t(); }
-		inline const float& r2D() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_Transform2D.r(); }
-		inline const f2& s2D() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_Transform2D.s(); }
+		inline transform2D tf2D() const { return transform2D(t2D(), r2D(), s2D()); }
+		inline f2 t2D() const { return t().xy(); }
+		inline const float& r2D() const { return r().z(); }
+		inline f2 s2D() const { return s().xy(); }
 
 		// 2D transform setters
-		inline void tf(const transform2D& transform) { m_TransformIsDirty = true; m_Transform = transform; }
-		inline void t(const f2& t) { m_TransformIsDirty = true; m_Transform.t().x(t.x()); m_Transform.t().y(t.y()); }
-		inline void r(float r) { m_TransformIsDirty = true; m_Transform.r().x(r); }
-		inline void s(const f2& s) { m_TransformIsDirty = true; m_Transform.s().x(s.x()); m_Transform.s().y(s.y()); }
+		inline void tf(const transform2D& transform) { t(transform.t()); r(transform.r()); s(transform.s()); }
+		inline void t(const f2& t) { MarkTransformDirty(); dataTranslation().x(t.x()).y(t.y()); }
+		inline void r(float r) { MarkTransformDirty(); dataRotation().z(r); }
+		inline void s(const f2& s) { MarkTransformDirty(); dataScale().x(s.x()).y(s.y()); }
 
 		// AABB getters
-		inline const aabb3Df& aabb_local() const { return m_AABB; }
-		inline const aabb3Df& aabb_world() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_AABBWorld; }
-		inline const aabb2Df& aabb2D_local() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_AABB2D; }
-		inline const aabb2Df& aabb2D_world() { if (m_TransformIsDirty) { CalculateAABBs(); } return m_AABB2DWorld; }
+		inline const aabb3Df& aabb_local() const { return dataAABBLocal(); }
+		inline const aabb3Df& aabb_world() { CleanTransform(); return dataAABBWorld(); }
+		inline aabb2Df aabb2D_local() const { return aabb2Df(aabb_local().p1().xy(), aabb_local().p2().xy()); }
+		inline const aabb2Df& aabb2D_world() { CleanTransform(); return dataAABB2DWorld(); }
+
+		// AABB getters that never write the game object (for reading other game objects, which can be updated on other threads)
+		inline aabb3Df aabb_world_uncached() const { return HasFlag(FLAG_AABB_DIRTY) ? (aabb_local() * s()) + t() : dataAABBWorld(); }
+		inline aabb2Df aabb2D_world_uncached() const { if (!HasFlag(FLAG_AABB_DIRTY)) { return dataAABB2DWorld(); } aabb3Df aabb = aabb_world_uncached(); return aabb2Df(aabb.p1().xy(), aabb.p2().xy()); }
 
 		// AABB setters
-		inline void aabb_local(const aabb3Df& aabb) { m_AABB = aabb; m_TransformIsDirty = true; }
-		inline void aabb_local(const aabb2Df& aabb) { m_AABB = aabb3Df(aabb); m_TransformIsDirty = true; }
+		inline void aabb_local(const aabb3Df& aabb) { MarkTransformDirty(); dataAABBLocal() = aabb; }
+		inline void aabb_local(const aabb2Df& aabb) { MarkTransformDirty(); dataAABBLocal() = aabb3Df(aabb); }
 
 		// Velocity getters
-		inline const f3& velocity() const { return m_Velocity; }
-		inline f3& velocity() { return m_Velocity; }
-		inline f2 velocity2D() const { return m_Velocity.xy(); }
+		inline const f3& velocity() const { return dataVelocity(); }
+		inline f3& velocity() { return dataVelocity(); }
+		inline f2 velocity2D() const { return velocity().xy(); }
 
 		// Velocity setters
-		inline void velocity(const f3& v) { m_Velocity = v; }
-		inline void velocity(const f2& v) { m_Velocity.x(v.x()); m_Velocity.y(v.y()); }
+		inline void velocity(const f3& v) { dataVelocity() = v; }
+		inline void velocity(const f2& v) { dataVelocity().x(v.x()).y(v.y()); }
 	};
 }
 
@@ -1,6 +1,6 @@
 #include "GameObjectCollection.hpp"
 
-#include "CollisionManager.hpp" // For checking collisions
+#include "GameObjectQuery.hpp" // For filtering game objects
 #include <set> // For removing duplicate elements while merging game object collections
 
 ////////////////////////////////////////////////////////////////
@@ -19,120 +19,73 @@ Engine::GameObjectCollection& Engine::GameObjectCollection::merge(GameObjectColl
 // Filtering												  //
 ////////////////////////////////////////////////////////////////
 
-// Filters out game objects that do not match the specified GUID
-Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByGUID(GameObjectGUID guid)
+// Filters out game objects that do not match the query (all filters of the query are applied in a single pass)
+Engine::GameObjectCollection& Engine::GameObjectCollection::Filter(const GameObjectQuery& query)
 {
 	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
 	{
-		if ((*i)->guid() == guid) { i++; continue; }
+		if (query.Matches(*i)) { i++; continue; }
 		i = m_GameObjects.erase(i);
 	}
 	return (*this);
 }
 
+// Filters out game objects that do not match the specified GUID
+Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByGUID(GameObjectGUID guid)
+{
+	return Filter(GameObjectQuery().ByGUID(guid));
+}
+
 // Filters out game objects that do not match the specified type
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByType(GameObjectType type)
 {
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if ((*i)->type() == type) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByType(type));
 }
 
 // Filters out game objects outside of the specified interval
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByLocation(const interval2Df& interval)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->t2D(), interval)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByLocation(interval));
 }
 
 // Filters out game objects outside of the specified interval
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByLocation(const interval3Df& interval)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->t(), interval)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByLocation(interval));
 }
 
 // Filters out game objects outside of the specified circle
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByLocation(const circlef& circle)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->t2D(), circle)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByLocation(circle));
 }
 
 // Filters out game objects outside of the specified sphere
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByLocation(const spheref& sphere)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->t(), sphere)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByLocation(sphere));
 }
 
 // Filters out game objects that do not overlap with the specified interval
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByOverlap(const interval2Df& interval)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->aabb2D_world(), interval)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByOverlap(interval));
 }
 
 // Filters out game objects that do not overlap with the specified interval
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByOverlap(const interval3Df& interval)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->aabb_world(), interval)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByOverlap(interval));
 }
 
 // Filters out game objects that do not overlap with the specified circle
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByOverlap(const circlef& circle)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->aabb2D_world(), circle)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByOverlap(circle));
 }
 
 // Filters out game objects that do not overlap with the specified sphere
 Engine::GameObjectCollection& Engine::GameObjectCollection::FilterByOverlap(const spheref& sphere)
 {
-	CollisionManager& c = CollisionManager::GetInstance();
-	for (auto i = m_GameObjects.begin(); i != m_GameObjects.end();)
-	{
-		if (c.IsIntersecting((*i)->aabb_world(), sphere)) { i++; continue; }
-		i = m_GameObjects.erase(i);
-	}
-	return (*this);
+	return Filter(GameObjectQuery().ByOverlap(sphere));
 }
\ No newline at end of file
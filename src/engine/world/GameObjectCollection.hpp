@@ -10,6 +10,8 @@
 
 namespace Engine{
 
+	class GameObjectQuery;
+
 	class GameObjectCollection{
 
 	private:
@@ -56,6 +58,9 @@ namespace Engine{
 		// Filtering												  //
 		////////////////////////////////////////////////////////////////
 
+		// Filters out game objects that do not match the query (all filters of the query are applied in a single pass)
+		GameObjectCollection& Filter(const GameObjectQuery& query);
+
 		// Filters out game objects that do not match the specified GUID
 		GameObjectCollection& FilterByGUID(GameObjectGUID guid);
 
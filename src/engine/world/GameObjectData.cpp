@@ -0,0 +1,167 @@
+#include "GameObjectData.hpp"
+
+#include "GameObject.hpp" // For updating the data location of game objects
+#include "../debugging/LoggingManager.hpp" // For reporting a full store
+
+#include <algorithm> // For sorting the slots freed while moving game objects was deferred
+#include <functional> // For sorting in descending order
+
+// Allocates a slot for a game object and copies its detached data into it (also assigns the handle of the game object)
+bool Engine::GameObjectDataStore::Allocate(GameObject* owner)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (owner->m_Data != NULL) { return true; }
+
+	// Refuse the game object if the block table or the slot map is full
+	size_t blockIndex = m_Size / GameObjectDataBlock::s_Capacity;
+	if (blockIndex >= s_MaxBlocks || (m_FreeSlots.empty() && m_SlotCount.load() >= s_MaxSlotPages * s_SlotPageSize))
+	{
+		LoggingManager::GetInstance().Log(LoggingManager::LogType::Error, "Game object data store is full, the game object is not added to the world");
+		return false;
+	}
+
+	// Assign a handle slot (reuse freed slots first)
+	unsigned int slotIndex;
+	if (m_FreeSlots.empty())
+	{
+		slotIndex = m_SlotCount.load();
+		if (slotIndex % s_SlotPageSize == 0) { m_SlotPages[slotIndex / s_SlotPageSize].reset(new Slot[s_SlotPageSize]); }
+		Slot& slot = m_SlotPages[slotIndex / s_SlotPageSize][slotIndex % s_SlotPageSize];
+		slot.m_Object.store(owner, std::memory_order_relaxed);
+		slot.m_Generation.store(0, std::memory_order_relaxed);
+		m_SlotCount.store(slotIndex + 1, std::memory_order_release);
+	}
+	else
+	{
+		slotIndex = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+		m_SlotPages[slotIndex / s_SlotPageSize][slotIndex % s_SlotPageSize].m_Object.store(owner, std::memory_order_release);
+	}
+	owner->m_GUID = GameObjectHandle(slotIndex, m_SlotPages[slotIndex / s_SlotPageSize][slotIndex % s_SlotPageSize].m_Generation.load(std::memory_order_relaxed));
+
+	// Add a new block if all blocks are full
+	if (!m_Blocks[blockIndex]) { CreateBlock(blockIndex); }
+
+	// Initialize the slot at the end of the store (the size is increased last, so other threads never see a partially initialized slot)
+	GameObjectDataBlock& b = *m_Blocks[blockIndex];
+	const GameObjectDetachedData& detached = owner->m_Detached;
+	size_t i = b.m_Size;
+	b.m_Owner[i] = owner;
+	b.m_Flags[i] = FLAG_AABB_DIRTY;
+	b.m_Translation[i] = detached.m_Translation;
+	b.m_Rotation[i] = detached.m_Rotation;
+	b.m_Scale[i] = detached.m_Scale;
+	b.m_Velocity[i] = detached.m_Velocity;
+	b.m_AABBLocal[i] = detached.m_AABBLocal;
+	b.m_Size++;
+	m_Size++;
+
+	owner->m_Data = &b;
+	owner->m_DataIndex = i;
+	return true;
+}
+
+// Frees the slot of a game object (moves the last game object into the freed slot, and invalidates its handle)
+void Engine::GameObjectDataStore::Free(GameObject* owner)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// Invalidate the handle by advancing the generation of its slot
+	unsigned int slotIndex = owner->handle().index();
+	Slot& slot = m_SlotPages[slotIndex / s_SlotPageSize][slotIndex % s_SlotPageSize];
+	slot.m_Object.store(NULL, std::memory_order_relaxed);
+	slot.m_Generation.fetch_add(1, std::memory_order_release);
+	m_FreeSlots.push_back(slotIndex);
+
+	GameObjectDataBlock& b = *owner->m_Data;
+	size_t i = owner->m_DataIndex;
+	owner->m_Data = NULL;
+
+	// Leave a hole if other game objects may currently be accessing their data
+	if (m_DeferFree)
+	{
+		b.m_Owner[i] = NULL;
+		b.m_Flags[i] = 0;
+		m_DeferredFrees.push_back(b.m_Index * GameObjectDataBlock::s_Capacity + i);
+		return;
+	}
+
+	MoveLastInto(b, i);
+}
+
+// Defers moving game objects into freed slots until EndDeferredFree() is called
+void Engine::GameObjectDataStore::BeginDeferredFree()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_DeferFree = true;
+}
+
+// Moves game objects into the slots that were freed since BeginDeferredFree() was called
+void Engine::GameObjectDataStore::EndDeferredFree()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_DeferFree = false;
+
+	// Fill holes from the back, so the last game object is never a hole that still has to be filled
+	std::sort(m_DeferredFrees.begin(), m_DeferredFrees.end(), std::greater<size_t>());
+	for (size_t index : m_DeferredFrees)
+	{
+		MoveLastInto(*m_Blocks[index / GameObjectDataBlock::s_Capacity], index % GameObjectDataBlock::s_Capacity);
+	}
+	m_DeferredFrees.clear();
+}
+
+// Reserves blocks for holding at least the specified number of game objects
+void Engine::GameObjectDataStore::Reserve(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (size_t bi = 0; bi * GameObjectDataBlock::s_Capacity < capacity && bi < s_MaxBlocks; bi++)
+	{
+		if (!m_Blocks[bi]) { CreateBlock(bi); }
+	}
+}
+
+// Recalculates the world AABBs of all game objects marked as dirty (in a single pass)
+void Engine::GameObjectDataStore::UpdateAABBs()
+{
+	for (size_t bi = 0; bi < blockCount(); bi++)
+	{
+		GameObjectDataBlock& b = *m_Blocks[bi];
+		for (size_t i = 0; i < b.m_Size; i++)
+		{
+			if ((b.m_Flags[i] & FLAG_AABB_DIRTY) != 0) { b.CalculateAABBs(i); }
+		}
+	}
+}
+
+// Creates the block at the specified index of the block table
+void Engine::GameObjectDataStore::CreateBlock(size_t index)
+{
+	m_Blocks[index].reset(new GameObjectDataBlock(index));
+}
+
+// Moves the last game object of the store into the specified slot, and shrinks the store
+void Engine::GameObjectDataStore::MoveLastInto(GameObjectDataBlock& b, size_t i)
+{
+	GameObjectDataBlock& last = *m_Blocks[(m_Size - 1) / GameObjectDataBlock::s_Capacity];
+	size_t l = last.m_Size - 1;
+
+	// Move the last game object into the freed slot to keep the store dense
+	if (&b != &last || i != l)
+	{
+		b.m_Owner[i] = last.m_Owner[l];
+		b.m_Flags[i] = last.m_Flags[l];
+		b.m_Translation[i] = last.m_Translation[l];
+		b.m_Rotation[i] = last.m_Rotation[l];
+		b.m_Scale[i] = last.m_Scale[l];
+		b.m_Velocity[i] = last.m_Velocity[l];
+		b.m_AABBLocal[i] = last.m_AABBLocal[l];
+		b.m_AABBWorld[i] = last.m_AABBWorld[l];
+		b.m_AABB2DWorld[i] = last.m_AABB2DWorld[l];
+		b.m_Owner[i]->m_Data = &b;
+		b.m_Owner[i]->m_DataIndex = i;
+	}
+
+	last.m_Size--;
+	m_Size--;
+}
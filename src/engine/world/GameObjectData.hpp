@@ -0,0 +1,212 @@
+#pragma once
+#ifndef ENGINE_WORLD_GAMEOBJECTDATA_H
+#define ENGINE_WORLD_GAMEOBJECTDATA_H
+
+#include "../common/utility/VectorTypes.hpp" // For representing translations, rotations, scales and velocities
+#include "../common/utility/TransformTypes.hpp" // For initializing game object data from a transform
+#include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "GameObjectHandle.hpp" // For resolving game object handles
+
+#include <vector> // For holding the data blocks
+#include <memory> // For owning the data blocks
+#include <mutex> // For allocating and freeing slots from multiple threads
+#include <atomic> // For reading the number of game objects and the slot generations while other threads allocate
+
+namespace Engine{
+
+	class GameObject;
+
+	// Typedef for per-object flags
+	typedef unsigned char GameObjectFlags;
+
+	// The world AABBs of the game object need to be recalculated
+	static const GameObjectFlags FLAG_AABB_DIRTY = 0x01;
+
+	// The game object has been added to the game world
+	static const GameObjectFlags FLAG_IN_WORLD = 0x02;
+
+	// The world AABBs of the game object have changed since the spatial index was last synchronized
+	static const GameObjectFlags FLAG_BOUNDS_MOVED = 0x04;
+
+	// The AABB of the game object has changed since the contacts were last updated
+	static const GameObjectFlags FLAG_CONTACT_MOVED = 0x08;
+
+	// The broadphase proxy of the game object has changed since the contacts were last updated
+	static const GameObjectFlags FLAG_PROXY_MOVED = 0x10;
+
+	// Engine-owned data of a game object that has not been added to the world (copied into the store when it is added)
+	struct GameObjectDetachedData
+	{
+		GameObjectFlags m_Flags;
+		f3 m_Translation;
+		f3 m_Rotation;
+		f3 m_Scale;
+		f3 m_Velocity;
+		aabb3Df m_AABBLocal;
+		aabb3Df m_AABBWorld;
+		aabb2Df m_AABB2DWorld;
+
+		// Recalculates the world AABBs
+		inline void CalculateAABBs()
+		{
+			m_AABBWorld = (m_AABBLocal * m_Scale) + m_Translation;
+			m_AABB2DWorld = aabb2Df(m_AABBWorld.p1().xy(), m_AABBWorld.p2().xy());
+			m_Flags &= ~FLAG_AABB_DIRTY;
+		}
+	};
+
+	// Block of engine-owned game object data, stored as struct-of-arrays
+	//		NOTE: blocks are never moved in memory, but freeing a game object
+	//		moves the last game object of the store into the freed slot. So
+	//		references to the data of a game object (e.g. returned by t() or
+	//		velocity()) are only valid until any game object is freed, which
+	//		happens when removed game objects are deleted after the update.
+	//		Do not hold on to them across frames.
+	struct GameObjectDataBlock
+	{
+		// Number of game objects that fit in a single block
+		static const size_t s_Capacity = 1024;
+
+		// Constructor
+		GameObjectDataBlock(size_t index) : m_Index(index), m_Size(0) { }
+
+		// Index of the block within the store
+		const size_t m_Index;
+
+		// Number of slots in use
+		std::atomic<size_t> m_Size;
+
+		// Per-object data
+		GameObject* m_Owner[s_Capacity];
+		GameObjectFlags m_Flags[s_Capacity];
+		f3 m_Translation[s_Capacity];
+		f3 m_Rotation[s_Capacity];
+		f3 m_Scale[s_Capacity];
+		f3 m_Velocity[s_Capacity];
+		aabb3Df m_AABBLocal[s_Capacity];
+		aabb3Df m_AABBWorld[s_Capacity];
+		aabb2Df m_AABB2DWorld[s_Capacity];
+
+		// Recalculates the world AABBs of the game object in the specified slot
+		inline void CalculateAABBs(size_t i)
+		{
+			m_AABBWorld[i] = (m_AABBLocal[i] * m_Scale[i]) + m_Translation[i];
+			m_AABB2DWorld[i] = aabb2Df(m_AABBWorld[i].p1().xy(), m_AABBWorld[i].p2().xy());
+			m_Flags[i] &= ~FLAG_AABB_DIRTY;
+			m_Flags[i] |= FLAG_BOUNDS_MOVED;
+		}
+	};
+
+	// Dense storage for the engine-owned data of all game objects
+	class GameObjectDataStore
+	{
+
+	public:
+
+		// Constructor
+		GameObjectDataStore() : m_Size(0), m_SlotCount(0), m_DeferFree(false) { }
+
+		// Allocates a slot for a game object and copies its detached data into it (also assigns the handle of the game object)
+		//		NOTE: called when the game object is added to the world, so game
+		//		objects that are never added (e.g. temporary instances on the
+		//		stack) do not take up a slot. Does nothing for game objects that
+		//		already have a slot. Returns false (and leaves the game object
+		//		without a slot) if the store is full.
+		bool Allocate(GameObject* owner);
+
+		// Frees the slot of a game object (moves the last game object into the freed slot, and invalidates its handle)
+		void Free(GameObject* owner);
+
+		// Defers moving game objects into freed slots until EndDeferredFree() is called
+		//		NOTE: this keeps the data of all game objects in place while they are 
+		//		updated from multiple threads. Freed slots are left as holes (without 
+		//		flags), which are skipped by all iterations over the store.
+		void BeginDeferredFree();
+
+		// Moves game objects into the slots that were freed since BeginDeferredFree() was called
+		void EndDeferredFree();
+
+		// Resolves a handle to its game object (returns NULL for stale handles)
+		//		NOTE: can be called while other threads allocate slots (e.g. when
+		//		spawning during a parallel update), as the slots are read 
+		//		atomically. Freeing slots is never done in parallel.
+		inline GameObject* Resolve(GameObjectHandle handle) const
+		{
+			if (!handle.IsValid() || handle.index() >= m_SlotCount.load(std::memory_order_acquire)) { return NULL; }
+			const Slot& slot = m_SlotPages[handle.index() / s_SlotPageSize][handle.index() % s_SlotPageSize];
+			if (slot.m_Generation.load(std::memory_order_acquire) != handle.generation()) { return NULL; }
+			return slot.m_Object.load(std::memory_order_acquire);
+		}
+
+		// Reserves blocks for holding at least the specified number of game objects
+		void Reserve(size_t capacity);
+
+		// Recalculates the world AABBs of all game objects marked as dirty (in a single pass)
+		void UpdateAABBs();
+
+		////////////////////////////////////////////////////////////////
+		// Block access												  //
+		////////////////////////////////////////////////////////////////
+
+		// Gets the number of game objects in the store
+		inline size_t size() const { return m_Size; }
+
+		// Gets the number of blocks in use
+		inline size_t blockCount() const { return (m_Size + GameObjectDataBlock::s_Capacity - 1) / GameObjectDataBlock::s_Capacity; }
+
+		// Gets a block
+		inline GameObjectDataBlock& block(size_t index) { return *m_Blocks[index]; }
+		inline const GameObjectDataBlock& block(size_t index) const { return *m_Blocks[index]; }
+
+	private:
+
+		// Maximum number of blocks (the block table is never reallocated, so blocks can be added while other threads iterate the store)
+		static const size_t s_MaxBlocks = 4096;
+
+		// Blocks holding the game object data
+		std::unique_ptr<GameObjectDataBlock> m_Blocks[s_MaxBlocks];
+
+		// Number of game objects in the store (including holes left by deferred frees)
+		std::atomic<size_t> m_Size;
+
+		// Slot of the handle slot map (written under the mutex, read atomically by Resolve())
+		struct Slot
+		{
+			std::atomic<GameObject*> m_Object;
+			std::atomic<unsigned int> m_Generation;
+		};
+
+		// Number of slots per slot page
+		static const size_t s_SlotPageSize = 1024;
+
+		// Maximum number of slot pages (the page table is never reallocated, so handles can be resolved while other threads allocate)
+		static const size_t s_MaxSlotPages = 4096;
+
+		// Slot map for resolving handles (paged, indexed by handle index)
+		std::unique_ptr<Slot[]> m_SlotPages[s_MaxSlotPages];
+
+		// Number of slots that have been handed out (increased once the slot is initialized, so other threads never resolve a partially initialized slot)
+		std::atomic<unsigned int> m_SlotCount;
+
+		// Indices of slots that can be reused
+		std::vector<unsigned int> m_FreeSlots;
+
+		// Mutex guarding allocation and freeing of slots
+		std::mutex m_Mutex;
+
+		// Whether moving game objects into freed slots is deferred
+		bool m_DeferFree;
+
+		// Store indices of the slots freed while moving game objects was deferred
+		std::vector<size_t> m_DeferredFrees;
+
+		// Creates the block at the specified index of the block table
+		void CreateBlock(size_t index);
+
+		// Moves the last game object of the store into the specified slot, and shrinks the store
+		void MoveLastInto(GameObjectDataBlock& b, size_t i);
+
+	};
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef ENGINE_WORLD_GAMEOBJECTHANDLE_H
+#define ENGINE_WORLD_GAMEOBJECTHANDLE_H
+
+namespace Engine{
+
+	// Typedef for game object globally unique IDs
+	typedef unsigned long long GameObjectGUID;
+
+	// Handle to a game object (slot index and generation of the slot)
+	//		NOTE: the handle packs into a GameObjectGUID (generation in the
+	//		upper 32 bits, slot index in the lower 32 bits), so code that
+	//		stores GUIDs can pass them wherever a handle is expected. When a
+	//		game object is removed, the generation of its slot is incremented,
+	//		so stale handles no longer resolve to a game object.
+	struct GameObjectHandle
+	{
+
+	private:
+
+		unsigned int m_Index;
+		unsigned int m_Generation;
+
+	public:
+
+		// Constructors
+		GameObjectHandle() : m_Index(s_InvalidIndex), m_Generation(0) { }
+		GameObjectHandle(unsigned int index, unsigned int generation) : m_Index(index), m_Generation(generation) { }
+		GameObjectHandle(GameObjectGUID guid) : m_Index((unsigned int)(guid & 0xFFFFFFFFull)), m_Generation((unsigned int)(guid >> 32)) { }
+
+		// Casts
+		inline operator GameObjectGUID() const { return ((GameObjectGUID)m_Generation << 32) | (GameObjectGUID)m_Index; }
+
+		// Getters
+		inline unsigned int index() const { return m_Index; }
+		inline unsigned int generation() const { return m_Generation; }
+
+		// Operators
+		inline bool operator== (const GameObjectHandle& other) const { return (m_Index == other.m_Index && m_Generation == other.m_Generation); }
+		inline bool operator!= (const GameObjectHandle& other) const { return !(*this == other); }
+
+		// Checks whether the handle has been assigned a slot
+		inline bool IsValid() const { return m_Index != s_InvalidIndex; }
+
+		// Slot index of handles that do not refer to a game object
+		static const unsigned int s_InvalidIndex = 0xFFFFFFFF;
+	};
+}
+
+#endif
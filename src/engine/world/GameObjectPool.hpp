@@ -0,0 +1,148 @@
+#pragma once
+#ifndef ENGINE_WORLD_GAMEOBJECTPOOL_H
+#define ENGINE_WORLD_GAMEOBJECTPOOL_H
+
+#include "GameObject.hpp" // For constructing and destroying pooled game objects
+
+#include <vector> // For holding the chunks and free slots of a pool
+#include <memory> // For owning the chunks of a pool
+#include <mutex> // For spawning game objects from multiple threads
+#include <string> // For naming pools in their statistics
+#include <type_traits> // For obtaining properly aligned storage for game objects
+#include <typeinfo> // For naming pools after the pooled type
+#include <new> // For constructing game objects in pool slots
+
+namespace Engine{
+
+	// Allocation statistics of a game object pool
+	struct GameObjectPoolStats
+	{
+		std::string m_Name;				// Name of the pooled type
+		size_t m_Capacity;				// Number of slots in the pool
+		size_t m_Occupancy;				// Number of slots holding a game object
+		size_t m_PeakOccupancy;			// Largest number of slots that held a game object at the same time
+		size_t m_Allocations;			// Number of game objects constructed in the pool
+		size_t m_ChunkAllocations;		// Number of times the pool had to grow
+	};
+
+	// Base class of per-type game object pools
+	class GameObjectPoolBase
+	{
+
+	public:
+
+		// Destructor
+		//		NOTE: game objects that are still alive when the pool is destroyed
+		//		are not destructed (game objects are not destroyed on shutdown).
+		virtual ~GameObjectPoolBase() { }
+
+		// Destructs a pooled game object and returns its slot to the pool
+		virtual void Release(GameObject* gameObject) = 0;
+
+		// Makes sure the pool has at least the specified number of slots
+		virtual void Reserve(size_t capacity) = 0;
+
+		// Gets the allocation statistics of the pool
+		virtual GameObjectPoolStats stats() const = 0;
+
+	protected:
+
+		// Marks a game object as being owned by a pool
+		static inline void SetPool(GameObject* gameObject, GameObjectPoolBase* pool) { gameObject->m_Pool = pool; }
+
+	};
+
+	// Pool of game objects of a single type (slots are reused through a free list, and never move in memory)
+	template<typename T>
+	class GameObjectPool : public GameObjectPoolBase
+	{
+
+	public:
+
+		// Constructor
+		GameObjectPool() : m_Capacity(0), m_Occupancy(0), m_PeakOccupancy(0), m_Allocations(0), m_ChunkAllocations(0) { }
+
+		// Constructs a game object in a free slot of the pool
+		template<typename... Args>
+		T* Construct(Args&&... args)
+		{
+			Slot* slot;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_FreeSlots.empty()) { AddChunk(); }
+				slot = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+				m_Occupancy++;
+				m_Allocations++;
+				if (m_Occupancy > m_PeakOccupancy) { m_PeakOccupancy = m_Occupancy; }
+			}
+
+			T* gameObject = new (slot) T(std::forward<Args>(args)...);
+			SetPool(gameObject, this);
+			return gameObject;
+		}
+
+		// Destructs a pooled game object and returns its slot to the pool
+		virtual void Release(GameObject* gameObject)
+		{
+			T* pooled = static_cast<T*>(gameObject);
+			pooled->~T();
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_FreeSlots.push_back(reinterpret_cast<Slot*>(pooled));
+			m_Occupancy--;
+		}
+
+		// Makes sure the pool has at least the specified number of slots
+		virtual void Reserve(size_t capacity)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			while (m_Capacity < capacity) { AddChunk(); }
+		}
+
+		// Gets the allocation statistics of the pool
+		virtual GameObjectPoolStats stats() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			GameObjectPoolStats stats = { typeid(T).name(), m_Capacity, m_Occupancy, m_PeakOccupancy, m_Allocations, m_ChunkAllocations };
+			return stats;
+		}
+
+	private:
+
+		// Number of game objects per chunk
+		static const size_t s_ChunkSize = 256;
+
+		// Storage for a single game object
+		typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type Slot;
+
+		// Chunks of slots
+		std::vector<std::unique_ptr<Slot[]>> m_Chunks;
+
+		// Slots that do not hold a game object
+		std::vector<Slot*> m_FreeSlots;
+
+		// Mutex guarding the chunks, the free list and the statistics
+		mutable std::mutex m_Mutex;
+
+		// Statistics
+		size_t m_Capacity;
+		size_t m_Occupancy;
+		size_t m_PeakOccupancy;
+		size_t m_Allocations;
+		size_t m_ChunkAllocations;
+
+		// Adds a chunk of free slots to the pool (lowest addresses are handed out first)
+		void AddChunk()
+		{
+			m_Chunks.push_back(std::unique_ptr<Slot[]>(new Slot[s_ChunkSize]));
+			Slot* chunk = m_Chunks.back().get();
+			for (size_t i = s_ChunkSize; i > 0; i--) { m_FreeSlots.push_back(&chunk[i - 1]); }
+			m_Capacity += s_ChunkSize;
+			m_ChunkAllocations++;
+		}
+
+	};
+}
+
+#endif
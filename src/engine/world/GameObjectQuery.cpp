@@ -0,0 +1,147 @@
+#include "GameObjectQuery.hpp"
+
+#include "../debugging/LoggingManager.hpp" // For reporting queries that hold too many filters
+
+////////////////////////////////////////////////////////////////
+// Filtering												  //
+////////////////////////////////////////////////////////////////
+
+// Only matches game objects with the specified GUID
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByGUID(GameObjectGUID guid)
+{
+	Filter* filter = AddFilter(Filter::Type::GUID);
+	if (filter != NULL) { filter->m_GUID = guid; }
+	return (*this);
+}
+
+// Only matches game objects of the specified type
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByType(GameObjectType type)
+{
+	Filter* filter = AddFilter(Filter::Type::TYPE);
+	if (filter != NULL) { filter->m_ObjectType = type; }
+	return (*this);
+}
+
+// Only matches game objects located inside the specified interval
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByLocation(const interval2Df& interval)
+{
+	Filter* filter = AddFilter(Filter::Type::LOCATION_INTERVAL2D);
+	if (filter != NULL) { filter->m_Interval2D = interval; }
+	return (*this);
+}
+
+// Only matches game objects located inside the specified interval
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByLocation(const interval3Df& interval)
+{
+	Filter* filter = AddFilter(Filter::Type::LOCATION_INTERVAL3D);
+	if (filter != NULL) { filter->m_Interval3D = interval; }
+	return (*this);
+}
+
+// Only matches game objects located inside the specified circle
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByLocation(const circlef& circle)
+{
+	Filter* filter = AddFilter(Filter::Type::LOCATION_CIRCLE);
+	if (filter != NULL) { filter->m_Circle = circle; }
+	return (*this);
+}
+
+// Only matches game objects located inside the specified sphere
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByLocation(const spheref& sphere)
+{
+	Filter* filter = AddFilter(Filter::Type::LOCATION_SPHERE);
+	if (filter != NULL) { filter->m_Sphere = sphere; }
+	return (*this);
+}
+
+// Only matches game objects that overlap with the specified interval
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByOverlap(const interval2Df& interval)
+{
+	Filter* filter = AddFilter(Filter::Type::OVERLAP_INTERVAL2D);
+	if (filter != NULL) { filter->m_Interval2D = interval; }
+	return (*this);
+}
+
+// Only matches game objects that overlap with the specified interval
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByOverlap(const interval3Df& interval)
+{
+	Filter* filter = AddFilter(Filter::Type::OVERLAP_INTERVAL3D);
+	if (filter != NULL) { filter->m_Interval3D = interval; }
+	return (*this);
+}
+
+// Only matches game objects that overlap with the specified circle
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByOverlap(const circlef& circle)
+{
+	Filter* filter = AddFilter(Filter::Type::OVERLAP_CIRCLE);
+	if (filter != NULL) { filter->m_Circle = circle; }
+	return (*this);
+}
+
+// Only matches game objects that overlap with the specified sphere
+Engine::GameObjectQuery& Engine::GameObjectQuery::ByOverlap(const spheref& sphere)
+{
+	Filter* filter = AddFilter(Filter::Type::OVERLAP_SPHERE);
+	if (filter != NULL) { filter->m_Sphere = sphere; }
+	return (*this);
+}
+
+// Does not match the specified game object (e.g. the game object that runs the query)
+Engine::GameObjectQuery& Engine::GameObjectQuery::Excluding(const GameObject* gameObject)
+{
+	Filter* filter = AddFilter(Filter::Type::EXCLUDE);
+	if (filter != NULL) { filter->m_GameObject = gameObject; }
+	return (*this);
+}
+
+////////////////////////////////////////////////////////////////
+// Evaluation												  //
+////////////////////////////////////////////////////////////////
+
+// Appends all matching game objects to a list (returns the number of game objects appended)
+size_t Engine::GameObjectQuery::Collect(std::vector<GameObject*>& out_GameObjects) const
+{
+	size_t count = out_GameObjects.size();
+	ForEach([&out_GameObjects](GameObject* g) { out_GameObjects.push_back(g); });
+	return out_GameObjects.size() - count;
+}
+
+// Writes matching game objects to an array, up to the specified capacity (returns the number of game objects written)
+size_t Engine::GameObjectQuery::Collect(GameObject** out_GameObjects, size_t capacity) const
+{
+	size_t count = 0;
+	ForEach([out_GameObjects, capacity, &count](GameObject* g) { if (count < capacity) { out_GameObjects[count++] = g; } });
+	return count;
+}
+
+// Adds all matching game objects to a game object collection (returns the number of game objects added)
+size_t Engine::GameObjectQuery::Collect(GameObjectCollection& out_GameObjectCollection) const
+{
+	size_t count = out_GameObjectCollection.objects().size();
+	ForEach([&out_GameObjectCollection](GameObject* g) { out_GameObjectCollection.objects().insert(g); });
+	return out_GameObjectCollection.objects().size() - count;
+}
+
+// Counts the matching game objects
+size_t Engine::GameObjectQuery::Count() const
+{
+	size_t count = 0;
+	ForEach([&count](GameObject* g) { count++; });
+	return count;
+}
+
+// Records a filter (returns the filter to fill in, or NULL and invalidates the query if the query is full)
+Engine::GameObjectQuery::Filter* Engine::GameObjectQuery::AddFilter(Filter::Type type)
+{
+	// Dropping the filter would return a superset of the results, so the query matches nothing instead
+	if (m_FilterCount == s_MaxFilters)
+	{
+		if (!m_Invalid) { LoggingManager::GetInstance().Log(LoggingManager::LogType::Error, "Game object query holds more than " + std::to_string(s_MaxFilters) + " filters, the query matches no game objects"); }
+		m_Invalid = true;
+		return NULL;
+	}
+
+	Filter& filter = m_Filters[m_FilterCount++];
+	filter.m_Type = type;
+	return &filter;
+}
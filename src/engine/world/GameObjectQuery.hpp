@@ -0,0 +1,219 @@
+#pragma once
+#ifndef ENGINE_WORLD_GAMEOBJECTQUERY_H
+#define ENGINE_WORLD_GAMEOBJECTQUERY_H
+
+#include "GameObject.hpp" // For representing game objects
+#include "GameObjectData.hpp" // For querying all game objects in the world
+#include "GameObjectSpan.hpp" // For querying contiguous ranges of game objects
+#include "GameObjectCollection.hpp" // For querying game object collections
+#include "CollisionManager.hpp" // For testing locations and overlaps
+#include "../common/utility/IntervalTypes.hpp" // For representing location intervals
+#include "../common/utility/ShapeTypes.hpp" // For representing circles and spheres
+
+#include <vector> // For collecting query results
+
+namespace Engine{
+
+	// Lazy query over a source of game objects
+	//		NOTE: filters are only recorded when they are added, and are evaluated
+	//		together in a single pass over the source once the results are iterated
+	//		or collected. Queries do not allocate memory: filters are stored inline
+	//		and results are written to storage provided by the caller. A query
+	//		holds up to s_MaxFilters filters. Adding more filters makes the query 
+	//		invalid, after which it matches no game objects at all.
+	class GameObjectQuery
+	{
+
+	public:
+
+		// Maximum number of filters in a single query
+		static const size_t s_MaxFilters = 8;
+
+		// Constructors
+		GameObjectQuery() : m_Source(Source::NONE), m_Collection(NULL), m_Store(NULL), m_FilterCount(0), m_Invalid(false) { }
+		GameObjectQuery(const GameObjectSpan& span) : m_Source(Source::SPAN), m_Span(span), m_Collection(NULL), m_Store(NULL), m_FilterCount(0), m_Invalid(false) { }
+		GameObjectQuery(const GameObjectCollection& collection) : m_Source(Source::COLLECTION), m_Collection(&collection), m_Store(NULL), m_FilterCount(0), m_Invalid(false) { }
+		GameObjectQuery(const GameObjectDataStore& store) : m_Source(Source::STORE), m_Collection(NULL), m_Store(&store), m_FilterCount(0), m_Invalid(false) { }
+
+		////////////////////////////////////////////////////////////////
+		// Filtering												  //
+		////////////////////////////////////////////////////////////////
+
+		// Only matches game objects with the specified GUID
+		GameObjectQuery& ByGUID(GameObjectGUID guid);
+
+		// Only matches game objects of the specified type
+		GameObjectQuery& ByType(GameObjectType type);
+
+		// Only matches game objects located inside the specified interval
+		GameObjectQuery& ByLocation(const interval2Df& interval);
+
+		// Only matches game objects located inside the specified interval
+		GameObjectQuery& ByLocation(const interval3Df& interval);
+
+		// Only matches game objects located inside the specified circle
+		GameObjectQuery& ByLocation(const circlef& circle);
+
+		// Only matches game objects located inside the specified sphere
+		GameObjectQuery& ByLocation(const spheref& sphere);
+
+		// Only matches game objects that overlap with the specified interval
+		GameObjectQuery& ByOverlap(const interval2Df& interval);
+
+		// Only matches game objects that overlap with the specified interval
+		GameObjectQuery& ByOverlap(const interval3Df& interval);
+
+		// Only matches game objects that overlap with the specified circle
+		GameObjectQuery& ByOverlap(const circlef& circle);
+
+		// Only matches game objects that overlap with the specified sphere
+		GameObjectQuery& ByOverlap(const spheref& sphere);
+
+		// Does not match the specified game object (e.g. the game object that runs the query)
+		GameObjectQuery& Excluding(const GameObject* gameObject);
+
+		////////////////////////////////////////////////////////////////
+		// Evaluation												  //
+		////////////////////////////////////////////////////////////////
+
+		// Checks whether the query holds more filters than it can store (invalid queries match no game objects)
+		inline bool IsInvalid() const { return m_Invalid; }
+
+		// Checks whether a game object passes all filters of the query (ignores the source)
+		inline bool Matches(GameObject* gameObject) const
+		{
+			if (m_Invalid) { return false; }
+			for (size_t i = 0; i < m_FilterCount; i++)
+			{
+				if (!m_Filters[i].Matches(gameObject)) { return false; }
+			}
+			return true;
+		}
+
+		// Calls a function on every game object of the source that passes all filters
+		template<typename function>
+		inline void ForEach(function f) const
+		{
+			if (m_Invalid) { return; }
+			switch (m_Source)
+			{
+			case Source::SPAN:
+				for (GameObject* g : m_Span) { if (Matches(g)) { f(g); } }
+				break;
+			case Source::COLLECTION:
+				for (GameObject* g : m_Collection->objects()) { if (Matches(g)) { f(g); } }
+				break;
+			case Source::STORE:
+				for (size_t bi = 0; bi < m_Store->blockCount(); bi++)
+				{
+					const GameObjectDataBlock& b = m_Store->block(bi);
+					for (size_t i = 0; i < b.m_Size; i++)
+					{
+						if ((b.m_Flags[i] & FLAG_IN_WORLD) != 0 && Matches(b.m_Owner[i])) { f(b.m_Owner[i]); }
+					}
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		// Appends all matching game objects to a list (returns the number of game objects appended)
+		size_t Collect(std::vector<GameObject*>& out_GameObjects) const;
+
+		// Writes matching game objects to an array, up to the specified capacity (returns the number of game objects written)
+		size_t Collect(GameObject** out_GameObjects, size_t capacity) const;
+
+		// Adds all matching game objects to a game object collection (returns the number of game objects added)
+		size_t Collect(GameObjectCollection& out_GameObjectCollection) const;
+
+		// Counts the matching game objects
+		size_t Count() const;
+
+	private:
+
+		// Sources a query can run over
+		enum class Source
+		{
+			NONE,			// No source (the query is only used for matching)
+			SPAN,			// Contiguous range of game objects
+			COLLECTION,		// Game object collection
+			STORE			// All game objects in the world
+		};
+
+		// Recorded query filter
+		struct Filter
+		{
+			// Types of query filters
+			enum class Type
+			{
+				GUID,
+				TYPE,
+				EXCLUDE,
+				LOCATION_INTERVAL2D,
+				LOCATION_INTERVAL3D,
+				LOCATION_CIRCLE,
+				LOCATION_SPHERE,
+				OVERLAP_INTERVAL2D,
+				OVERLAP_INTERVAL3D,
+				OVERLAP_CIRCLE,
+				OVERLAP_SPHERE
+			};
+
+			// Constructor (the filter value is set once the type is known)
+			Filter() : m_Type(Type::GUID), m_GUID(0) { }
+
+			// Type of the filter, and the value of the filter (one per type)
+			Type m_Type;
+			union
+			{
+				GameObjectGUID m_GUID;
+				GameObjectType m_ObjectType;
+				const GameObject* m_GameObject;
+				interval2Df m_Interval2D;
+				interval3Df m_Interval3D;
+				circlef m_Circle;
+				spheref m_Sphere;
+			};
+
+			// Checks whether a game object passes the filter
+			inline bool Matches(GameObject* g) const
+			{
+				switch (m_Type)
+				{
+				case Type::GUID: return g->guid() == m_GUID;
+				case Type::TYPE: return g->type() == m_ObjectType;
+				case Type::EXCLUDE: return g != m_GameObject;
+				case Type::LOCATION_INTERVAL2D: return CollisionManager::IsIntersecting(g->t2D(), m_Interval2D);
+				case Type::LOCATION_INTERVAL3D: return CollisionManager::IsIntersecting(g->t(), m_Interval3D);
+				case Type::LOCATION_CIRCLE: return CollisionManager::IsIntersecting(g->t2D(), m_Circle);
+				case Type::LOCATION_SPHERE: return CollisionManager::IsIntersecting(g->t(), m_Sphere);
+				case Type::OVERLAP_INTERVAL2D: return CollisionManager::IsIntersecting(g->aabb2D_world_uncached(), m_Interval2D);
+				case Type::OVERLAP_INTERVAL3D: return CollisionManager::IsIntersecting(g->aabb_world_uncached(), m_Interval3D);
+				case Type::OVERLAP_CIRCLE: return CollisionManager::IsIntersecting(g->aabb2D_world_uncached(), m_Circle);
+				case Type::OVERLAP_SPHERE: return CollisionManager::IsIntersecting(g->aabb_world_uncached(), m_Sphere);
+				}
+				return false;
+			}
+		};
+
+		// Source of the query
+		Source m_Source;
+		GameObjectSpan m_Span;
+		const GameObjectCollection* m_Collection;
+		const GameObjectDataStore* m_Store;
+
+		// Recorded filters
+		Filter m_Filters[s_MaxFilters];
+		size_t m_FilterCount;
+
+		// Whether more filters were added than the query can store
+		bool m_Invalid;
+
+		// Records a filter (returns the filter to fill in, or NULL and invalidates the query if the query is full)
+		Filter* AddFilter(Filter::Type type);
+
+	};
+}
+
+#endif
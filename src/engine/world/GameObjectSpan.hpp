@@ -0,0 +1,47 @@
+#pragma once
+#ifndef ENGINE_WORLD_GAMEOBJECTSPAN_H
+#define ENGINE_WORLD_GAMEOBJECTSPAN_H
+
+#include <cstddef> // For size_t
+
+namespace Engine{
+
+	class GameObject;
+
+	// Non-owning view on a contiguous range of game objects
+	//		NOTE: spans returned by the WorldManager are valid until game objects
+	//		are added to or removed from the world. Game objects that are added or
+	//		removed during the update are applied after the update, so spans
+	//		retrieved during the update stay valid for the rest of the update.
+	class GameObjectSpan
+	{
+
+	public:
+
+		// Constructors
+		GameObjectSpan() : m_Begin(NULL), m_Size(0) { }
+		GameObjectSpan(GameObject* const* begin, size_t size) : m_Begin(begin), m_Size(size) { }
+
+		// Iterators
+		inline GameObject* const* begin() const { return m_Begin; }
+		inline GameObject* const* end() const { return m_Begin + m_Size; }
+
+		// Getters
+		inline size_t size() const { return m_Size; }
+		inline bool empty() const { return m_Size == 0; }
+
+		// Operators
+		inline GameObject* operator[] (size_t index) const { return m_Begin[index]; }
+
+	private:
+
+		// First game object of the span
+		GameObject* const* m_Begin;
+
+		// Number of game objects in the span
+		size_t m_Size;
+
+	};
+}
+
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef ENGINE_WORLD_NEARESTGAMEOBJECTHEAP_H
+#define ENGINE_WORLD_NEARESTGAMEOBJECTHEAP_H
+
+#include <vector> // For holding the heap
+#include <algorithm> // For maintaining and sorting the heap
+#include <limits> // For starting without a distance bound
+
+namespace Engine{
+
+	class GameObject;
+
+	// Bounded max-heap holding the k nearest game objects found so far (by squared distance)
+	//		NOTE: the farthest of the k game objects is on top of the heap, so
+	//		offering a game object is O(log k), and the squared distance of the
+	//		top bounds the search once k game objects have been found. The heap
+	//		keeps its memory between searches, so it is meant to be reused.
+	class NearestGameObjectHeap
+	{
+
+	public:
+
+		// Constructor
+		NearestGameObjectHeap() : m_K(0) { }
+
+		// Starts a new search for the k nearest game objects
+		inline void Reset(size_t k) { m_Heap.clear(); m_K = k; }
+
+		// Gets the squared distance a game object must be within to be among the k nearest
+		inline float bound() const { return (m_Heap.size() < m_K) ? std::numeric_limits<float>::max() : m_Heap.front().m_DistanceSquared; }
+
+		// Offers a game object (keeps it if it is among the k nearest so far)
+		inline void Offer(float distanceSquared, GameObject* gameObject)
+		{
+			if (m_Heap.size() < m_K)
+			{
+				Neighbour neighbour = { distanceSquared, gameObject };
+				m_Heap.push_back(neighbour);
+				std::push_heap(m_Heap.begin(), m_Heap.end());
+			}
+			else if (m_K > 0 && distanceSquared < m_Heap.front().m_DistanceSquared)
+			{
+				std::pop_heap(m_Heap.begin(), m_Heap.end());
+				m_Heap.back().m_DistanceSquared = distanceSquared;
+				m_Heap.back().m_GameObject = gameObject;
+				std::push_heap(m_Heap.begin(), m_Heap.end());
+			}
+		}
+
+		// Writes the game objects to a buffer, nearest first (returns the number of game objects written)
+		inline size_t Write(GameObject** out_GameObjects)
+		{
+			std::sort_heap(m_Heap.begin(), m_Heap.end());
+			for (size_t i = 0; i < m_Heap.size(); i++) { out_GameObjects[i] = m_Heap[i].m_GameObject; }
+			return m_Heap.size();
+		}
+
+	private:
+
+		// Game object with its squared distance
+		struct Neighbour
+		{
+			float m_DistanceSquared;
+			GameObject* m_GameObject;
+
+			inline bool operator<(const Neighbour& other) const { return m_DistanceSquared < other.m_DistanceSquared; }
+		};
+
+		// Heap of the nearest game objects found so far (farthest on top)
+		std::vector<Neighbour> m_Heap;
+
+		// Number of game objects to find
+		size_t m_K;
+
+	};
+}
+
+#endif
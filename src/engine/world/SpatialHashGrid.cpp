@@ -0,0 +1,127 @@
+#include "SpatialHashGrid.hpp"
+
+#include <cmath> // For finding the cells that contain a coordinate
+
+// Constructor (with the size of the cells, and the margin by which AABBs are enlarged)
+Engine::SpatialHashGrid::SpatialHashGrid(float cellSize, float margin)
+	: m_FreeList(PROXY_INVALID), m_ProxyCount(0), m_CellSize(cellSize), m_Margin(margin)
+{
+
+}
+
+////////////////////////////////////////////////////////////////
+// Proxies                                                    //
+////////////////////////////////////////////////////////////////
+
+// Creates a proxy for a game object, with a tag and category bits for filtering queries (returns its proxy ID)
+Engine::ProxyID Engine::SpatialHashGrid::CreateProxy(const aabb2Df& aabb, GameObject* gameObject, unsigned int tag, unsigned int category)
+{
+	// Take a proxy from the free list, or grow the proxy pool
+	ProxyID id = m_FreeList;
+	if (id == PROXY_INVALID)
+	{
+		m_Proxies.push_back(Proxy());
+		id = ProxyID(m_Proxies.size() - 1);
+	}
+	else { m_FreeList = m_Proxies[id].m_NextFree; }
+
+	Proxy& proxy = m_Proxies[id];
+	proxy.m_AABB = aabb2Df(aabb.x1() - m_Margin, aabb.x2() + m_Margin, aabb.y1() - m_Margin, aabb.y2() + m_Margin);
+	proxy.m_GameObject = gameObject;
+	proxy.m_Tag = tag;
+	proxy.m_Category = category;
+	proxy.m_Cells = GetCellRange(proxy.m_AABB);
+	proxy.m_NextFree = PROXY_INVALID;
+	InsertIntoCells(id);
+	m_ProxyCount++;
+	return id;
+}
+
+// Destroys a proxy
+void Engine::SpatialHashGrid::DestroyProxy(ProxyID proxy)
+{
+	RemoveFromCells(proxy);
+	m_Proxies[proxy].m_GameObject = NULL;
+	m_Proxies[proxy].m_NextFree = m_FreeList;
+	m_FreeList = proxy;
+	m_ProxyCount--;
+}
+
+// Moves a proxy (returns whether the fat AABB of the proxy changed)
+bool Engine::SpatialHashGrid::MoveProxy(ProxyID proxy, const aabb2Df& aabb)
+{
+	// Keep the proxy in place while the AABB stays inside the fat AABB
+	Proxy& p = m_Proxies[proxy];
+	if (p.m_AABB.x1() <= aabb.x1() && p.m_AABB.y1() <= aabb.y1() && aabb.x2() <= p.m_AABB.x2() && aabb.y2() <= p.m_AABB.y2()) { return false; }
+
+	p.m_AABB = aabb2Df(aabb.x1() - m_Margin, aabb.x2() + m_Margin, aabb.y1() - m_Margin, aabb.y2() + m_Margin);
+	CellRange cells = GetCellRange(p.m_AABB);
+	if (cells == p.m_Cells) { return true; }
+
+	RemoveFromCells(proxy);
+	m_Proxies[proxy].m_Cells = cells;
+	InsertIntoCells(proxy);
+	return true;
+}
+
+// Removes all proxies
+void Engine::SpatialHashGrid::Clear()
+{
+	m_Proxies.clear();
+	m_Cells.clear();
+	m_FreeList = PROXY_INVALID;
+	m_ProxyCount = 0;
+}
+
+////////////////////////////////////////////////////////////////
+// Cells                                                      //
+////////////////////////////////////////////////////////////////
+
+// Gets the range of cells overlapped by an AABB
+Engine::SpatialHashGrid::CellRange Engine::SpatialHashGrid::GetCellRange(const aabb2Df& aabb) const
+{
+	CellRange range;
+	range.m_X1 = int(floor(aabb.x1() / m_CellSize));
+	range.m_Y1 = int(floor(aabb.y1() / m_CellSize));
+	range.m_X2 = int(floor(aabb.x2() / m_CellSize));
+	range.m_Y2 = int(floor(aabb.y2() / m_CellSize));
+	return range;
+}
+
+// Adds a proxy to all cells in its cell range
+void Engine::SpatialHashGrid::InsertIntoCells(ProxyID proxy)
+{
+	const CellRange& range = m_Proxies[proxy].m_Cells;
+	for (int y = range.m_Y1; y <= range.m_Y2; y++)
+	{
+		for (int x = range.m_X1; x <= range.m_X2; x++)
+		{
+			Cell& cell = m_Cells[GetCellKey(x, y)];
+			cell.m_X = x;
+			cell.m_Y = y;
+			cell.m_Proxies.push_back(proxy);
+		}
+	}
+}
+
+// Removes a proxy from all cells in its cell range (drops cells that become empty)
+void Engine::SpatialHashGrid::RemoveFromCells(ProxyID proxy)
+{
+	const CellRange& range = m_Proxies[proxy].m_Cells;
+	for (int y = range.m_Y1; y <= range.m_Y2; y++)
+	{
+		for (int x = range.m_X1; x <= range.m_X2; x++)
+		{
+			auto cell = m_Cells.find(GetCellKey(x, y));
+			if (cell == m_Cells.end()) { continue; }
+
+			// Move the last proxy of the cell into the place of the removed proxy
+			std::vector<ProxyID>& proxies = cell->second.m_Proxies;
+			for (size_t i = 0; i < proxies.size(); i++)
+			{
+				if (proxies[i] == proxy) { proxies[i] = proxies.back(); proxies.pop_back(); break; }
+			}
+			if (proxies.empty()) { m_Cells.erase(cell); }
+		}
+	}
+}
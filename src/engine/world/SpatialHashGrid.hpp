@@ -0,0 +1,194 @@
+#pragma once
+#ifndef ENGINE_WORLD_SPATIALHASHGRID_H
+#define ENGINE_WORLD_SPATIALHASHGRID_H
+
+#include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "DynamicAABBTree.hpp" // For sharing the proxy IDs of the broadphases
+
+#include <vector> // For holding the proxies, and the proxies in each cell
+#include <unordered_map> // For mapping cell coordinates to the occupied cells
+
+namespace Engine{
+
+	class GameObject;
+
+	// Uniform grid of square cells, hashed by cell coordinates, for querying game objects by area
+	//		NOTE: each proxy is stored in every cell its fat AABB overlaps, so
+	//		the grid works best when most game objects are about the size of a
+	//		cell or smaller (e.g. tile-sized sprites). Only occupied cells are
+	//		stored, so the world does not need to be bounded. Like the dynamic
+	//		AABB tree, proxies store a fat AABB and only move between cells when
+	//		the AABB of the game object leaves its fat AABB.
+	class SpatialHashGrid
+	{
+
+	public:
+
+		// Constructor (with the size of the cells, and the margin by which AABBs are enlarged)
+		SpatialHashGrid(float cellSize = 16.0f, float margin = 0.0f);
+
+		// Creates a proxy for a game object, with a tag and category bits for filtering queries (returns its proxy ID)
+		ProxyID CreateProxy(const aabb2Df& aabb, GameObject* gameObject, unsigned int tag = 0, unsigned int category = 0);
+
+		// Destroys a proxy
+		void DestroyProxy(ProxyID proxy);
+
+		// Moves a proxy (returns whether the fat AABB of the proxy changed)
+		bool MoveProxy(ProxyID proxy, const aabb2Df& aabb);
+
+		// Removes all proxies
+		void Clear();
+
+		// Gets the fat AABB of a proxy
+		inline const aabb2Df& fatAABB(ProxyID proxy) const { return m_Proxies[proxy].m_AABB; }
+
+		// Gets the game object of a proxy
+		inline GameObject* gameObject(ProxyID proxy) const { return m_Proxies[proxy].m_GameObject; }
+
+		// Gets the tag of a proxy
+		inline unsigned int tag(ProxyID proxy) const { return m_Proxies[proxy].m_Tag; }
+
+		// Gets the category bits of a proxy
+		inline unsigned int category(ProxyID proxy) const { return m_Proxies[proxy].m_Category; }
+
+		// Changes the category bits of a proxy
+		inline void SetCategory(ProxyID proxy, unsigned int category) { m_Proxies[proxy].m_Category = category; }
+
+		// Gets the number of proxies in the grid
+		inline size_t size() const { return m_ProxyCount; }
+
+		// Gets the number of occupied cells
+		inline size_t cellCount() const { return m_Cells.size(); }
+
+		// Gets the size of the cells
+		inline float cellSize() const { return m_CellSize; }
+
+		// Gets the margin by which AABBs are enlarged
+		inline float margin() const { return m_Margin; }
+
+		// Calls a function on all game objects whose fat AABB overlaps with the specified area
+		//		NOTE: the function is called as f(gameObject, proxy), once per
+		//		proxy. A proxy in multiple cells is only reported from the first
+		//		cell it shares with the query area, so queries do not need to
+		//		mark visited proxies. Queries do not allocate memory and do not
+		//		modify the grid, so multiple threads can query the grid as long
+		//		as no proxies are changed.
+		template<typename function>
+		inline void Query(const aabb2Df& aabb, function f) const
+		{
+			if (m_ProxyCount == 0) { return; }
+			CellRange range = GetCellRange(aabb);
+
+			// Visit the occupied cells directly when the query covers more cells than are occupied
+			long long rangeCells = (long long)(range.m_X2 - range.m_X1 + 1) * (long long)(range.m_Y2 - range.m_Y1 + 1);
+			if (rangeCells > (long long)m_Cells.size())
+			{
+				for (const auto& cell : m_Cells)
+				{
+					if (range.Contains(cell.second.m_X, cell.second.m_Y)) { QueryCell(cell.second, range, aabb, f); }
+				}
+				return;
+			}
+
+			for (int y = range.m_Y1; y <= range.m_Y2; y++)
+			{
+				for (int x = range.m_X1; x <= range.m_X2; x++)
+				{
+					auto cell = m_Cells.find(GetCellKey(x, y));
+					if (cell != m_Cells.end()) { QueryCell(cell->second, range, aabb, f); }
+				}
+			}
+		}
+
+		// Calls a function on all proxies in the grid
+		//		NOTE: the function is called as f(gameObject, proxy).
+		template<typename function>
+		inline void ForEachProxy(function f) const
+		{
+			for (size_t i = 0; i < m_Proxies.size(); i++)
+			{
+				if (m_Proxies[i].m_GameObject != NULL) { f(m_Proxies[i].m_GameObject, ProxyID(i)); }
+			}
+		}
+
+	private:
+
+		// Range of cells (inclusive)
+		struct CellRange
+		{
+			int m_X1;
+			int m_Y1;
+			int m_X2;
+			int m_Y2;
+
+			inline bool Contains(int x, int y) const { return x >= m_X1 && x <= m_X2 && y >= m_Y1 && y <= m_Y2; }
+			inline bool operator==(const CellRange& other) const { return m_X1 == other.m_X1 && m_Y1 == other.m_Y1 && m_X2 == other.m_X2 && m_Y2 == other.m_Y2; }
+		};
+
+		// Proxy of a game object
+		struct Proxy
+		{
+			aabb2Df m_AABB;
+			GameObject* m_GameObject;	// NULL for free proxies
+			unsigned int m_Tag;
+			unsigned int m_Category;
+			CellRange m_Cells;			// Cells holding the proxy
+			ProxyID m_NextFree;			// Next free proxy, for proxies in the free list
+		};
+
+		// Occupied cell of the grid
+		struct Cell
+		{
+			int m_X;
+			int m_Y;
+			std::vector<ProxyID> m_Proxies;
+		};
+
+		// Proxies of the grid
+		std::vector<Proxy> m_Proxies;
+
+		// Occupied cells (mapped by cell key)
+		std::unordered_map<long long, Cell> m_Cells;
+
+		// First proxy of the free list
+		ProxyID m_FreeList;
+
+		// Number of proxies in the grid
+		size_t m_ProxyCount;
+
+		// Size of the cells
+		float m_CellSize;
+
+		// Margin by which AABBs are enlarged
+		float m_Margin;
+
+		// Gets the range of cells overlapped by an AABB
+		CellRange GetCellRange(const aabb2Df& aabb) const;
+
+		// Gets the key of the cell at the specified cell coordinates
+		static inline long long GetCellKey(int x, int y) { return ((long long)x << 32) | (long long)(unsigned int)y; }
+
+		// Adds a proxy to all cells in its cell range
+		void InsertIntoCells(ProxyID proxy);
+
+		// Removes a proxy from all cells in its cell range (drops cells that become empty)
+		void RemoveFromCells(ProxyID proxy);
+
+		// Calls a function on the proxies of a cell that overlap with the query area (and are reported from this cell)
+		template<typename function>
+		inline void QueryCell(const Cell& cell, const CellRange& range, const aabb2Df& aabb, function& f) const
+		{
+			for (ProxyID id : cell.m_Proxies)
+			{
+				const Proxy& proxy = m_Proxies[id];
+				int firstX = (proxy.m_Cells.m_X1 > range.m_X1) ? proxy.m_Cells.m_X1 : range.m_X1;
+				int firstY = (proxy.m_Cells.m_Y1 > range.m_Y1) ? proxy.m_Cells.m_Y1 : range.m_Y1;
+				if (cell.m_X != firstX || cell.m_Y != firstY) { continue; }
+				if (proxy.m_AABB.x1() <= aabb.x2() && aabb.x1() <= proxy.m_AABB.x2() && proxy.m_AABB.y1() <= aabb.y2() && aabb.y1() <= proxy.m_AABB.y2()) { f(proxy.m_GameObject, id); }
+			}
+		}
+
+	};
+}
+
+#endif
@@ -0,0 +1,168 @@
+#include "StaticGeometry.hpp"
+
+#include <algorithm> // For sorting the solid AABBs and their coordinates
+
+// Rebuilds the merged rectangles from the specified solid AABBs
+void Engine::StaticGeometry::Bake(const std::vector<Solid>& solids)
+{
+	Clear();
+
+	// Sort the solid AABBs by type and collision categories (in the order they were given within each group)
+	m_Order.resize(solids.size());
+	for (size_t i = 0; i < solids.size(); i++) { m_Order[i] = i; }
+	std::sort(m_Order.begin(), m_Order.end(), [&solids](size_t a, size_t b)
+	{
+		if (solids[a].m_Type != solids[b].m_Type) { return solids[a].m_Type < solids[b].m_Type; }
+		if (solids[a].m_Category != solids[b].m_Category) { return solids[a].m_Category < solids[b].m_Category; }
+		return a < b;
+	});
+
+	// Merge every group of solid AABBs that share their type and collision categories
+	size_t first = 0;
+	for (size_t i = 1; i <= m_Order.size(); i++)
+	{
+		if (i < m_Order.size() && solids[m_Order[i]].m_Type == solids[m_Order[first]].m_Type && solids[m_Order[i]].m_Category == solids[m_Order[first]].m_Category) { continue; }
+		Split(solids, first, i);
+		first = i;
+	}
+}
+
+// Removes all merged rectangles
+void Engine::StaticGeometry::Clear()
+{
+	m_Rectangles = DynamicAABBTree(0.0f);
+}
+
+// Splits the solid AABBs in a range of the sorted order (which share their type and collision categories) into regions, and merges every region
+void Engine::StaticGeometry::Split(const std::vector<Solid>& solids, size_t first, size_t last)
+{
+	if (first == last) { return; }
+	Region group = { first, last, true, true };
+	m_Regions.assign(1, group);
+	while (!m_Regions.empty())
+	{
+		// Split the region along the axes that can still have gaps (the parts of a split have no gaps along the axis they were split along)
+		Region region = m_Regions.back();
+		m_Regions.pop_back();
+		if (region.m_SplitX && SplitAlong(solids, region, true)) { continue; }
+		if (region.m_SplitY && SplitAlong(solids, region, false)) { continue; }
+
+		// Merge the region in the order the solid AABBs were given (so the same solid AABB keeps each cell as without splitting)
+		std::sort(m_Order.begin() + region.m_First, m_Order.begin() + region.m_Last);
+		Merge(solids, region.m_First, region.m_Last);
+	}
+}
+
+// Splits a region at every gap along an axis that no solid AABB spans, adding the parts to the regions that are not split yet (returns whether the region was split)
+bool Engine::StaticGeometry::SplitAlong(const std::vector<Solid>& solids, const Region& region, bool alongX)
+{
+	// Sort the solid AABBs of the region by their lower coordinate along the axis
+	auto lower = [&solids, alongX](size_t solid) { return alongX ? solids[solid].m_AABB.x1() : solids[solid].m_AABB.y1(); };
+	auto upper = [&solids, alongX](size_t solid) { return alongX ? solids[solid].m_AABB.x2() : solids[solid].m_AABB.y2(); };
+	std::sort(m_Order.begin() + region.m_First, m_Order.begin() + region.m_Last, [&lower](size_t a, size_t b) { return lower(a) < lower(b); });
+
+	// Start a new part at every solid AABB that starts after all previous solid AABBs end (touching solid AABBs stay in the same part)
+	size_t first = region.m_First;
+	float end = upper(m_Order[first]);
+	for (size_t i = region.m_First + 1; i <= region.m_Last; i++)
+	{
+		if (i < region.m_Last && lower(m_Order[i]) <= end)
+		{
+			end = std::max(end, upper(m_Order[i]));
+			continue;
+		}
+		if (first == region.m_First && i == region.m_Last) { return false; }
+
+		Region part = { first, i, !alongX, alongX };
+		m_Regions.push_back(part);
+		if (i < region.m_Last)
+		{
+			first = i;
+			end = upper(m_Order[i]);
+		}
+	}
+	return true;
+}
+
+// Merges the solid AABBs in a range of the sorted order (which share their type and collision categories)
+void Engine::StaticGeometry::Merge(const std::vector<Solid>& solids, size_t first, size_t last)
+{
+	// Collect the distinct coordinates of the solid AABBs, which split the area into a grid of cells
+	m_X.clear();
+	m_Y.clear();
+	for (size_t i = first; i < last; i++)
+	{
+		const aabb2Df& aabb = solids[m_Order[i]].m_AABB;
+		m_X.push_back(aabb.x1());
+		m_X.push_back(aabb.x2());
+		m_Y.push_back(aabb.y1());
+		m_Y.push_back(aabb.y2());
+	}
+	std::sort(m_X.begin(), m_X.end());
+	std::sort(m_Y.begin(), m_Y.end());
+	m_X.erase(std::unique(m_X.begin(), m_X.end()), m_X.end());
+	m_Y.erase(std::unique(m_Y.begin(), m_Y.end()), m_Y.end());
+	if (m_X.size() < 2 || m_Y.size() < 2) { return; }
+	size_t columns = m_X.size() - 1;
+	size_t rows = m_Y.size() - 1;
+
+	// Keep the solid AABBs of the region unmerged if they do not share a grid (the grid would grow quadratically with the number of solid AABBs)
+	if (columns * rows > (last - first) * s_MaxCellsPerSolid)
+	{
+		for (size_t i = first; i < last; i++)
+		{
+			const Solid& s = solids[m_Order[i]];
+			if (s.m_AABB.x1() < s.m_AABB.x2() && s.m_AABB.y1() < s.m_AABB.y2()) { m_Rectangles.CreateProxy(s.m_AABB, s.m_GameObject, s.m_Type, s.m_Category); }
+		}
+		return;
+	}
+
+	// Mark the cells covered by each solid AABB (the first solid AABB covering a cell keeps it)
+	m_Cells.assign(columns * rows, -1);
+	for (size_t i = first; i < last; i++)
+	{
+		const aabb2Df& aabb = solids[m_Order[i]].m_AABB;
+		size_t x1 = std::lower_bound(m_X.begin(), m_X.end(), aabb.x1()) - m_X.begin();
+		size_t x2 = std::lower_bound(m_X.begin(), m_X.end(), aabb.x2()) - m_X.begin();
+		size_t y1 = std::lower_bound(m_Y.begin(), m_Y.end(), aabb.y1()) - m_Y.begin();
+		size_t y2 = std::lower_bound(m_Y.begin(), m_Y.end(), aabb.y2()) - m_Y.begin();
+		for (size_t y = y1; y < y2; y++)
+		{
+			for (size_t x = x1; x < x2; x++)
+			{
+				if (m_Cells[y * columns + x] < 0) { m_Cells[y * columns + x] = int(m_Order[i]); }
+			}
+		}
+	}
+
+	// Greedily grow a rectangle from every covered cell, first along the row and then over the rows below it
+	for (size_t y = 0; y < rows; y++)
+	{
+		for (size_t x = 0; x < columns; x++)
+		{
+			int solid = m_Cells[y * columns + x];
+			if (solid < 0) { continue; }
+
+			size_t width = 1;
+			while (x + width < columns && m_Cells[y * columns + x + width] >= 0) { width++; }
+
+			size_t height = 1;
+			while (y + height < rows)
+			{
+				bool covered = true;
+				for (size_t i = 0; i < width && covered; i++) { covered = m_Cells[(y + height) * columns + x + i] >= 0; }
+				if (!covered) { break; }
+				height++;
+			}
+
+			// Take the cells of the rectangle, so they are not merged again
+			for (size_t j = 0; j < height; j++)
+			{
+				for (size_t i = 0; i < width; i++) { m_Cells[(y + j) * columns + x + i] = -1; }
+			}
+
+			const Solid& s = solids[solid];
+			m_Rectangles.CreateProxy(aabb2Df(m_X[x], m_X[x + width], m_Y[y], m_Y[y + height]), s.m_GameObject, s.m_Type, s.m_Category);
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef ENGINE_WORLD_STATICGEOMETRY_H
+#define ENGINE_WORLD_STATICGEOMETRY_H
+
+#include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "../common/utility/VectorTypes.hpp" // For representing the motion of swept queries
+#include "DynamicAABBTree.hpp" // For finding the merged rectangles near an area
+#include "CollisionFilter.hpp" // For filtering the merged rectangles by game object type and collision category
+
+#include <vector> // For holding the solid AABBs and the cells they cover
+
+namespace Engine{
+
+	class GameObject;
+
+	// Solid level geometry baked into maximal rectangles, for resolving movement against
+	//		NOTE: the AABBs of static game objects (e.g. solid tiles) are merged
+	//		into as few rectangles as possible, so a moving game object tests a
+	//		floor of many tiles as one collider, and cannot catch on the seams
+	//		in between tiles. Only AABBs with the same type and collision
+	//		categories are merged, so filters work the same as for the separate
+	//		game objects. The AABBs are merged on a grid of all their distinct x
+	//		and y coordinates, which suits AABBs aligned to a shared tile grid.
+	//		Groups are first split into regions at every gap along the x- or
+	//		y-axis that no AABB spans, so every region gets a grid of its own
+	//		(e.g. the separate platforms of a long level). Regions of AABBs that
+	//		are not aligned would need a grid that grows quadratically with the
+	//		number of AABBs, so if the grid has more than s_MaxCellsPerSolid
+	//		cells per AABB, the region is kept unmerged.
+	class StaticGeometry
+	{
+
+	public:
+
+		// Solid AABB of a static game object
+		struct Solid
+		{
+			aabb2Df m_AABB;
+			GameObject* m_GameObject;
+			unsigned int m_Type;
+			unsigned int m_Category;
+		};
+
+		// Maximum number of grid cells per solid AABB of a region that is merged (larger grids keep the AABBs of the region unmerged)
+		static const size_t s_MaxCellsPerSolid = 16;
+
+		// Constructor
+		StaticGeometry() { }
+
+		// Rebuilds the merged rectangles from the specified solid AABBs
+		//		NOTE: every rectangle keeps the game object of its first solid
+		//		AABB, which is reported as the game object that was hit.
+		void Bake(const std::vector<Solid>& solids);
+
+		// Removes all merged rectangles
+		void Clear();
+
+		// Gets the number of merged rectangles
+		inline size_t size() const { return m_Rectangles.size(); }
+
+		// Calls a function on all merged rectangles that match the filter and overlap with the AABB swept along the specified motion
+		//		NOTE: the function is called as f(aabb, gameObject). Like the
+		//		broadphase, the rectangles can be queried by multiple threads as
+		//		long as they are not baked at the same time.
+		template<typename function>
+		inline void QuerySwept(const aabb2Df& aabb, const f2& motion, const CollisionFilter& filter, function f) const
+		{
+			m_Rectangles.Query(aabb.sweep(motion), [&](GameObject* gameObject, ProxyID proxy)
+			{
+				if (filter.Matches(m_Rectangles.tag(proxy), m_Rectangles.category(proxy))) { f(m_Rectangles.fatAABB(proxy), gameObject); }
+			});
+		}
+
+	private:
+
+		// Tree holding the merged rectangles (without margin, so the fat AABBs are the rectangles themselves)
+		DynamicAABBTree m_Rectangles;
+
+		// Solid AABBs sorted by type and collision categories, and by position within the regions being split (reused between bakes)
+		std::vector<size_t> m_Order;
+
+		// Range of the sorted order that is not split yet, and the axes it can still be split along
+		struct Region
+		{
+			size_t m_First;
+			size_t m_Last;
+			bool m_SplitX;
+			bool m_SplitY;
+		};
+
+		// Regions that are not split yet (reused between bakes)
+		std::vector<Region> m_Regions;
+
+		// Distinct x and y coordinates of the solid AABBs being merged (reused between bakes)
+		std::vector<float> m_X;
+		std::vector<float> m_Y;
+
+		// Solid AABB covering each cell of the grid of coordinates, or -1 for empty and merged cells (reused between bakes)
+		std::vector<int> m_Cells;
+
+		// Splits the solid AABBs in a range of the sorted order (which share their type and collision categories) into regions, and merges every region
+		void Split(const std::vector<Solid>& solids, size_t first, size_t last);
+
+		// Splits a region at every gap along an axis that no solid AABB spans, adding the parts to the regions that are not split yet (returns whether the region was split)
+		bool SplitAlong(const std::vector<Solid>& solids, const Region& region, bool alongX);
+
+		// Merges the solid AABBs in a range of the sorted order (which share their type and collision categories)
+		void Merge(const std::vector<Solid>& solids, size_t first, size_t last);
+
+	};
+}
+
+#endif
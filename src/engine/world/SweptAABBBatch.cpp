@@ -0,0 +1,401 @@
+#include "SweptAABBBatch.hpp"
+
+#include "CollisionManager.hpp" // For testing candidates one at a time, and for calculating the first collision
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define ENGINE_WORLD_SWEPTAABBBATCH_X86
+#include <emmintrin.h> // For the SSE2 kernel
+#include <immintrin.h> // For the AVX2 kernel
+#ifdef _MSC_VER
+#include <intrin.h> // For detecting the features of the CPU
+#define ENGINE_TARGET_AVX2
+#else
+#include <cpuid.h> // For detecting the features of the CPU
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// Adds the AABB of a game object as a candidate
+void Engine::SweptAABBBatch::Add(const aabb2Df& aabb, GameObject* gameObject)
+{
+	// Grow the arrays by a whole packet at a time (the padding is never reported as hit)
+	if (m_Size == m_X1.size())
+	{
+		m_X1.resize(m_Size + s_PacketSize, 0.0f);
+		m_X2.resize(m_Size + s_PacketSize, 0.0f);
+		m_Y1.resize(m_Size + s_PacketSize, 0.0f);
+		m_Y2.resize(m_Size + s_PacketSize, 0.0f);
+	}
+
+	m_X1[m_Size] = aabb.x1();
+	m_X2[m_Size] = aabb.x2();
+	m_Y1[m_Size] = aabb.y1();
+	m_Y2[m_Size] = aabb.y2();
+	m_GameObjects.push_back(gameObject);
+	m_Size++;
+}
+
+// Finds the first candidate hit by an AABB moving along the specified motion (returns NULL if no candidate is hit)
+Engine::GameObject* Engine::SweptAABBBatch::FindFirst(const aabb2Df& aabb, const f2& motion, f2& out_Position, f2& out_Normal, float& out_Progression) const
+{
+	size_t first = m_Size;
+	switch (s_Kernel)
+	{
+	case Kernel::SCALAR:
+		first = FindFirstScalar(aabb, motion);
+		break;
+	case Kernel::SSE2:
+		first = FindFirstSSE2(aabb, motion);
+		break;
+	case Kernel::AVX2:
+		first = FindFirstAVX2(aabb, motion);
+		break;
+	}
+	if (first == m_Size) { return NULL; }
+
+	// Calculate the collision with the first candidate like the collision manager does for a single candidate
+	aabb2Df candidate(m_X1[first], m_X2[first], m_Y1[first], m_Y2[first]);
+	CollisionManager::IsIntersecting(aabb, candidate, motion, out_Position, out_Normal, out_Progression);
+	return m_GameObjects[first];
+}
+
+////////////////////////////////////////////////////////////////
+// Kernels                                                    //
+////////////////////////////////////////////////////////////////
+
+// Finds the index of the first candidate hit by the moving AABB, testing one candidate at a time
+size_t Engine::SweptAABBBatch::FindFirstScalar(const aabb2Df& aabb, const f2& motion) const
+{
+	size_t first = m_Size;
+	float firstProgression = 1.0f;
+	f2 position;
+	f2 normal;
+	float progression;
+	for (size_t i = 0; i < m_Size; i++)
+	{
+		aabb2Df candidate(m_X1[i], m_X2[i], m_Y1[i], m_Y2[i]);
+		if (CollisionManager::IsIntersecting(aabb, candidate, motion, position, normal, progression) && progression < firstProgression)
+		{
+			firstProgression = progression;
+			first = i;
+		}
+	}
+	return first;
+}
+
+#ifdef ENGINE_WORLD_SWEPTAABBBATCH_X86
+
+// Finds the index of the first candidate hit by the moving AABB, testing 4 candidates at a time
+//		NOTE: follows the swept AABB test of the collision manager operation
+//		by operation (the moving AABB is converted to a ray, and every
+//		candidate is grown by the extent of the moving AABB). Halving is done
+//		by multiplying with 0.5, which is exact like dividing by 2. The slab
+//		updates of the four boundaries are applied in the same order and with
+//		the same strict comparisons, so NaN lambdas are ignored in the same way.
+size_t Engine::SweptAABBBatch::FindFirstSSE2(const aabb2Df& aabb, const f2& motion) const
+{
+	// Ray of the center of the moving AABB, and the extent of the moving AABB
+	float startX = (aabb.x1() + aabb.x2()) / 2.0f;
+	float startY = (aabb.y1() + aabb.y2()) / 2.0f;
+	__m128 sx = _mm_set1_ps(startX);
+	__m128 sy = _mm_set1_ps(startY);
+	__m128 ex = _mm_set1_ps(startX + motion.x());
+	__m128 ey = _mm_set1_ps(startY + motion.y());
+	__m128 aex = _mm_set1_ps((aabb.x2() - aabb.x1()) / 2.0f);
+	__m128 aey = _mm_set1_ps((aabb.y2() - aabb.y1()) / 2.0f);
+
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 sign = _mm_set1_ps(-0.0f);
+	const __m128i size = _mm_set1_epi32(int(m_Size));
+	const __m128i step = _mm_set1_epi32(4);
+
+	// First hit of every lane (lanes see every fourth candidate in order, so strict comparisons keep the earliest candidate)
+	__m128 firstProgression = one;
+	__m128i first = size;
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+	for (size_t i = 0; i < m_Size; i += 4, index = _mm_add_epi32(index, step))
+	{
+		__m128 bx1 = _mm_loadu_ps(&m_X1[i]);
+		__m128 bx2 = _mm_loadu_ps(&m_X2[i]);
+		__m128 by1 = _mm_loadu_ps(&m_Y1[i]);
+		__m128 by2 = _mm_loadu_ps(&m_Y2[i]);
+
+		// Candidate grown by the extent of the moving AABB
+		__m128 cex = _mm_add_ps(aex, _mm_mul_ps(_mm_sub_ps(bx2, bx1), half));
+		__m128 cey = _mm_add_ps(aey, _mm_mul_ps(_mm_sub_ps(by2, by1), half));
+		__m128 bcx = _mm_mul_ps(_mm_add_ps(bx1, bx2), half);
+		__m128 bcy = _mm_mul_ps(_mm_add_ps(by1, by2), half);
+		__m128 rx1 = _mm_sub_ps(bcx, cex);
+		__m128 rx2 = _mm_add_ps(bcx, cex);
+		__m128 ry1 = _mm_sub_ps(bcy, cey);
+		__m128 ry2 = _mm_add_ps(bcy, cey);
+
+		// Ray in local coordinates of the grown candidate
+		__m128 rcx = _mm_mul_ps(_mm_add_ps(rx1, rx2), half);
+		__m128 rcy = _mm_mul_ps(_mm_add_ps(ry1, ry2), half);
+		__m128 rex = _mm_mul_ps(_mm_sub_ps(rx2, rx1), half);
+		__m128 rey = _mm_mul_ps(_mm_sub_ps(ry2, ry1), half);
+		__m128 lx1 = _mm_sub_ps(sx, rcx);
+		__m128 ly1 = _mm_sub_ps(sy, rcy);
+		__m128 dx = _mm_sub_ps(_mm_sub_ps(ex, rcx), lx1);
+		__m128 dy = _mm_sub_ps(_mm_sub_ps(ey, rcy), ly1);
+
+		// Outcodes of the start and end of the ray (rays completely to one side of the candidate are rejected)
+		__m128 start1x = _mm_cmple_ps(sx, rx1);
+		__m128 start2x = _mm_cmpge_ps(sx, rx2);
+		__m128 start1y = _mm_cmple_ps(sy, ry1);
+		__m128 start2y = _mm_cmpge_ps(sy, ry2);
+		__m128 end1x = _mm_cmple_ps(ex, rx1);
+		__m128 end2x = _mm_cmpge_ps(ex, rx2);
+		__m128 end1y = _mm_cmple_ps(ey, ry1);
+		__m128 end2y = _mm_cmpge_ps(ey, ry2);
+		__m128 rejected = _mm_or_ps(_mm_or_ps(_mm_and_ps(start1x, end1x), _mm_and_ps(start2x, end2x)), _mm_or_ps(_mm_and_ps(start1y, end1y), _mm_and_ps(start2y, end2y)));
+
+		// Lambdas of the four boundaries
+		__m128 nx = _mm_xor_ps(lx1, sign);
+		__m128 ny = _mm_xor_ps(ly1, sign);
+		__m128 lambda1x = _mm_div_ps(_mm_sub_ps(nx, rex), dx);
+		__m128 lambda2x = _mm_div_ps(_mm_add_ps(nx, rex), dx);
+		__m128 lambda1y = _mm_div_ps(_mm_sub_ps(ny, rey), dy);
+		__m128 lambda2y = _mm_div_ps(_mm_add_ps(ny, rey), dy);
+
+		// Enter the boundaries the ray starts outside of, and exit the boundaries the ray ends outside of
+		__m128 enter = zero;
+		__m128 exit = one;
+		__m128 mask;
+		mask = _mm_and_ps(start1x, _mm_cmpgt_ps(lambda1x, enter)); enter = _mm_or_ps(_mm_and_ps(mask, lambda1x), _mm_andnot_ps(mask, enter));
+		mask = _mm_andnot_ps(start1x, _mm_and_ps(end1x, _mm_cmplt_ps(lambda1x, exit))); exit = _mm_or_ps(_mm_and_ps(mask, lambda1x), _mm_andnot_ps(mask, exit));
+		mask = _mm_and_ps(start2x, _mm_cmpgt_ps(lambda2x, enter)); enter = _mm_or_ps(_mm_and_ps(mask, lambda2x), _mm_andnot_ps(mask, enter));
+		mask = _mm_andnot_ps(start2x, _mm_and_ps(end2x, _mm_cmplt_ps(lambda2x, exit))); exit = _mm_or_ps(_mm_and_ps(mask, lambda2x), _mm_andnot_ps(mask, exit));
+		mask = _mm_and_ps(start1y, _mm_cmpgt_ps(lambda1y, enter)); enter = _mm_or_ps(_mm_and_ps(mask, lambda1y), _mm_andnot_ps(mask, enter));
+		mask = _mm_andnot_ps(start1y, _mm_and_ps(end1y, _mm_cmplt_ps(lambda1y, exit))); exit = _mm_or_ps(_mm_and_ps(mask, lambda1y), _mm_andnot_ps(mask, exit));
+		mask = _mm_and_ps(start2y, _mm_cmpgt_ps(lambda2y, enter)); enter = _mm_or_ps(_mm_and_ps(mask, lambda2y), _mm_andnot_ps(mask, enter));
+		mask = _mm_andnot_ps(start2y, _mm_and_ps(end2y, _mm_cmplt_ps(lambda2y, exit))); exit = _mm_or_ps(_mm_and_ps(mask, lambda2y), _mm_andnot_ps(mask, exit));
+
+		// Keep the hits that come before the first hit of the lane (padding lanes are never hit)
+		__m128 progression = _mm_min_ps(_mm_max_ps(enter, zero), one);
+		__m128 valid = _mm_castsi128_ps(_mm_cmplt_epi32(index, size));
+		__m128 hit = _mm_andnot_ps(rejected, _mm_and_ps(valid, _mm_cmple_ps(enter, exit)));
+		mask = _mm_and_ps(hit, _mm_cmplt_ps(progression, firstProgression));
+		firstProgression = _mm_or_ps(_mm_and_ps(mask, progression), _mm_andnot_ps(mask, firstProgression));
+		first = _mm_castps_si128(_mm_or_ps(_mm_and_ps(mask, _mm_castsi128_ps(index)), _mm_andnot_ps(mask, _mm_castsi128_ps(first))));
+	}
+
+	// Pick the lane with the lowest progression (the earliest candidate on ties)
+	float progressions[4];
+	int indices[4];
+	_mm_storeu_ps(progressions, firstProgression);
+	_mm_storeu_si128((__m128i*)indices, first);
+	size_t result = m_Size;
+	float resultProgression = 1.0f;
+	for (int lane = 0; lane < 4; lane++)
+	{
+		if (size_t(indices[lane]) == m_Size) { continue; }
+		if (progressions[lane] < resultProgression || (progressions[lane] == resultProgression && size_t(indices[lane]) < result))
+		{
+			resultProgression = progressions[lane];
+			result = size_t(indices[lane]);
+		}
+	}
+	return result;
+}
+
+// Finds the index of the first candidate hit by the moving AABB, testing 8 candidates at a time
+//		NOTE: same operations as the SSE2 kernel, on 8 lanes.
+ENGINE_TARGET_AVX2 size_t Engine::SweptAABBBatch::FindFirstAVX2(const aabb2Df& aabb, const f2& motion) const
+{
+	// Ray of the center of the moving AABB, and the extent of the moving AABB
+	float startX = (aabb.x1() + aabb.x2()) / 2.0f;
+	float startY = (aabb.y1() + aabb.y2()) / 2.0f;
+	__m256 sx = _mm256_set1_ps(startX);
+	__m256 sy = _mm256_set1_ps(startY);
+	__m256 ex = _mm256_set1_ps(startX + motion.x());
+	__m256 ey = _mm256_set1_ps(startY + motion.y());
+	__m256 aex = _mm256_set1_ps((aabb.x2() - aabb.x1()) / 2.0f);
+	__m256 aey = _mm256_set1_ps((aabb.y2() - aabb.y1()) / 2.0f);
+
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	const __m256i size = _mm256_set1_epi32(int(m_Size));
+	const __m256i step = _mm256_set1_epi32(8);
+
+	// First hit of every lane
+	__m256 firstProgression = one;
+	__m256i first = size;
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	for (size_t i = 0; i < m_Size; i += 8, index = _mm256_add_epi32(index, step))
+	{
+		__m256 bx1 = _mm256_loadu_ps(&m_X1[i]);
+		__m256 bx2 = _mm256_loadu_ps(&m_X2[i]);
+		__m256 by1 = _mm256_loadu_ps(&m_Y1[i]);
+		__m256 by2 = _mm256_loadu_ps(&m_Y2[i]);
+
+		// Candidate grown by the extent of the moving AABB
+		__m256 cex = _mm256_add_ps(aex, _mm256_mul_ps(_mm256_sub_ps(bx2, bx1), half));
+		__m256 cey = _mm256_add_ps(aey, _mm256_mul_ps(_mm256_sub_ps(by2, by1), half));
+		__m256 bcx = _mm256_mul_ps(_mm256_add_ps(bx1, bx2), half);
+		__m256 bcy = _mm256_mul_ps(_mm256_add_ps(by1, by2), half);
+		__m256 rx1 = _mm256_sub_ps(bcx, cex);
+		__m256 rx2 = _mm256_add_ps(bcx, cex);
+		__m256 ry1 = _mm256_sub_ps(bcy, cey);
+		__m256 ry2 = _mm256_add_ps(bcy, cey);
+
+		// Ray in local coordinates of the grown candidate
+		__m256 rcx = _mm256_mul_ps(_mm256_add_ps(rx1, rx2), half);
+		__m256 rcy = _mm256_mul_ps(_mm256_add_ps(ry1, ry2), half);
+		__m256 rex = _mm256_mul_ps(_mm256_sub_ps(rx2, rx1), half);
+		__m256 rey = _mm256_mul_ps(_mm256_sub_ps(ry2, ry1), half);
+		__m256 lx1 = _mm256_sub_ps(sx, rcx);
+		__m256 ly1 = _mm256_sub_ps(sy, rcy);
+		__m256 dx = _mm256_sub_ps(_mm256_sub_ps(ex, rcx), lx1);
+		__m256 dy = _mm256_sub_ps(_mm256_sub_ps(ey, rcy), ly1);
+
+		// Outcodes of the start and end of the ray (rays completely to one side of the candidate are rejected)
+		__m256 start1x = _mm256_cmp_ps(sx, rx1, _CMP_LE_OQ);
+		__m256 start2x = _mm256_cmp_ps(sx, rx2, _CMP_GE_OQ);
+		__m256 start1y = _mm256_cmp_ps(sy, ry1, _CMP_LE_OQ);
+		__m256 start2y = _mm256_cmp_ps(sy, ry2, _CMP_GE_OQ);
+		__m256 end1x = _mm256_cmp_ps(ex, rx1, _CMP_LE_OQ);
+		__m256 end2x = _mm256_cmp_ps(ex, rx2, _CMP_GE_OQ);
+		__m256 end1y = _mm256_cmp_ps(ey, ry1, _CMP_LE_OQ);
+		__m256 end2y = _mm256_cmp_ps(ey, ry2, _CMP_GE_OQ);
+		__m256 rejected = _mm256_or_ps(_mm256_or_ps(_mm256_and_ps(start1x, end1x), _mm256_and_ps(start2x, end2x)), _mm256_or_ps(_mm256_and_ps(start1y, end1y), _mm256_and_ps(start2y, end2y)));
+
+		// Lambdas of the four boundaries
+		__m256 nx = _mm256_xor_ps(lx1, sign);
+		__m256 ny = _mm256_xor_ps(ly1, sign);
+		__m256 lambda1x = _mm256_div_ps(_mm256_sub_ps(nx, rex), dx);
+		__m256 lambda2x = _mm256_div_ps(_mm256_add_ps(nx, rex), dx);
+		__m256 lambda1y = _mm256_div_ps(_mm256_sub_ps(ny, rey), dy);
+		__m256 lambda2y = _mm256_div_ps(_mm256_add_ps(ny, rey), dy);
+
+		// Enter the boundaries the ray starts outside of, and exit the boundaries the ray ends outside of
+		__m256 enter = zero;
+		__m256 exit = one;
+		enter = _mm256_blendv_ps(enter, lambda1x, _mm256_and_ps(start1x, _mm256_cmp_ps(lambda1x, enter, _CMP_GT_OQ)));
+		exit = _mm256_blendv_ps(exit, lambda1x, _mm256_andnot_ps(start1x, _mm256_and_ps(end1x, _mm256_cmp_ps(lambda1x, exit, _CMP_LT_OQ))));
+		enter = _mm256_blendv_ps(enter, lambda2x, _mm256_and_ps(start2x, _mm256_cmp_ps(lambda2x, enter, _CMP_GT_OQ)));
+		exit = _mm256_blendv_ps(exit, lambda2x, _mm256_andnot_ps(start2x, _mm256_and_ps(end2x, _mm256_cmp_ps(lambda2x, exit, _CMP_LT_OQ))));
+		enter = _mm256_blendv_ps(enter, lambda1y, _mm256_and_ps(start1y, _mm256_cmp_ps(lambda1y, enter, _CMP_GT_OQ)));
+		exit = _mm256_blendv_ps(exit, lambda1y, _mm256_andnot_ps(start1y, _mm256_and_ps(end1y, _mm256_cmp_ps(lambda1y, exit, _CMP_LT_OQ))));
+		enter = _mm256_blendv_ps(enter, lambda2y, _mm256_and_ps(start2y, _mm256_cmp_ps(lambda2y, enter, _CMP_GT_OQ)));
+		exit = _mm256_blendv_ps(exit, lambda2y, _mm256_andnot_ps(start2y, _mm256_and_ps(end2y, _mm256_cmp_ps(lambda2y, exit, _CMP_LT_OQ))));
+
+		// Keep the hits that come before the first hit of the lane (padding lanes are never hit)
+		__m256 progression = _mm256_min_ps(_mm256_max_ps(enter, zero), one);
+		__m256 valid = _mm256_castsi256_ps(_mm256_cmpgt_epi32(size, index));
+		__m256 hit = _mm256_andnot_ps(rejected, _mm256_and_ps(valid, _mm256_cmp_ps(enter, exit, _CMP_LE_OQ)));
+		__m256 mask = _mm256_and_ps(hit, _mm256_cmp_ps(progression, firstProgression, _CMP_LT_OQ));
+		firstProgression = _mm256_blendv_ps(firstProgression, progression, mask);
+		first = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(first), _mm256_castsi256_ps(index), mask));
+	}
+
+	// Pick the lane with the lowest progression (the earliest candidate on ties)
+	float progressions[8];
+	int indices[8];
+	_mm256_storeu_ps(progressions, firstProgression);
+	_mm256_storeu_si256((__m256i*)indices, first);
+	_mm256_zeroupper();
+	size_t result = m_Size;
+	float resultProgression = 1.0f;
+	for (int lane = 0; lane < 8; lane++)
+	{
+		if (size_t(indices[lane]) == m_Size) { continue; }
+		if (progressions[lane] < resultProgression || (progressions[lane] == resultProgression && size_t(indices[lane]) < result))
+		{
+			resultProgression = progressions[lane];
+			result = size_t(indices[lane]);
+		}
+	}
+	return result;
+}
+
+// Checks whether the CPU supports a kernel
+bool Engine::SweptAABBBatch::IsSupported(Kernel kernel)
+{
+	// Read the feature flags of the CPU (leaf 1 for SSE2, AVX and OS support for saving AVX registers, leaf 7 for AVX2)
+	unsigned int leaf0[4] = { 0, 0, 0, 0 };
+	unsigned int leaf1[4] = { 0, 0, 0, 0 };
+	unsigned int leaf7[4] = { 0, 0, 0, 0 };
+#ifdef _MSC_VER
+	__cpuid((int*)leaf0, 0);
+	if (leaf0[0] >= 1) { __cpuid((int*)leaf1, 1); }
+	if (leaf0[0] >= 7) { __cpuidex((int*)leaf7, 7, 0); }
+#else
+	__cpuid(0, leaf0[0], leaf0[1], leaf0[2], leaf0[3]);
+	if (leaf0[0] >= 1) { __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]); }
+	if (leaf0[0] >= 7) { __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]); }
+#endif
+
+	switch (kernel)
+	{
+	case Kernel::SCALAR:
+		return true;
+	case Kernel::SSE2:
+		return (leaf1[3] & (1u << 26)) != 0;
+	case Kernel::AVX2:
+	{
+		// The OS has to save the AVX registers on context switches
+		if ((leaf1[2] & (1u << 27)) == 0 || (leaf1[2] & (1u << 28)) == 0) { return false; }
+#ifdef _MSC_VER
+		unsigned long long xcr0 = _xgetbv(0);
+#else
+		unsigned int xcr0Low, xcr0High;
+		__asm__ ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+		unsigned long long xcr0 = xcr0Low;
+#endif
+		return (xcr0 & 0x6) == 0x6 && (leaf7[1] & (1u << 5)) != 0;
+	}
+	}
+	return false;
+}
+
+#else
+
+// Finds the index of the first candidate hit by the moving AABB (SSE2 is not available on this platform)
+size_t Engine::SweptAABBBatch::FindFirstSSE2(const aabb2Df& aabb, const f2& motion) const
+{
+	return FindFirstScalar(aabb, motion);
+}
+
+// Finds the index of the first candidate hit by the moving AABB (AVX2 is not available on this platform)
+size_t Engine::SweptAABBBatch::FindFirstAVX2(const aabb2Df& aabb, const f2& motion) const
+{
+	return FindFirstScalar(aabb, motion);
+}
+
+// Checks whether the CPU supports a kernel
+bool Engine::SweptAABBBatch::IsSupported(Kernel kernel)
+{
+	return kernel == Kernel::SCALAR;
+}
+
+#endif
+
+// Selects the kernel that is used for testing candidates (returns false if the CPU does not support it)
+bool Engine::SweptAABBBatch::SetKernel(Kernel kernel)
+{
+	if (!IsSupported(kernel)) { return false; }
+	s_Kernel = kernel;
+	return true;
+}
+
+// Selects the widest kernel the CPU supports
+Engine::SweptAABBBatch::Kernel Engine::SweptAABBBatch::SelectKernel()
+{
+	if (IsSupported(Kernel::AVX2)) { return Kernel::AVX2; }
+	if (IsSupported(Kernel::SSE2)) { return Kernel::SSE2; }
+	return Kernel::SCALAR;
+}
+
+// Number of candidates tested at a time by the widest kernel
+const size_t Engine::SweptAABBBatch::s_PacketSize = 8;
+
+// Kernel that is used for testing candidates
+Engine::SweptAABBBatch::Kernel Engine::SweptAABBBatch::s_Kernel = Engine::SweptAABBBatch::SelectKernel();
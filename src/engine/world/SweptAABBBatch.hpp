@@ -0,0 +1,98 @@
+#pragma once
+#ifndef ENGINE_WORLD_SWEPTAABBBATCH_H
+#define ENGINE_WORLD_SWEPTAABBBATCH_H
+
+#include "../common/utility/ShapeTypes.hpp" // For representing AABBs
+#include "../common/utility/VectorTypes.hpp" // For representing the motion of the moving AABB
+
+#include <vector> // For holding the candidate AABBs
+
+namespace Engine{
+
+	class GameObject;
+
+	// Batch of candidate AABBs that a moving AABB is tested against (stored as a structure of arrays)
+	//		NOTE: the candidates are tested 4 (SSE2) or 8 (AVX2) at a time,
+	//		with the kernel selected at runtime for the current CPU. All
+	//		kernels follow the exact operations of the swept AABB test of the
+	//		collision manager, so they find the same first collision. The
+	//		position, normal and progression of the first collision are then
+	//		calculated by the collision manager, so they are bit-identical to
+	//		testing the candidates one at a time.
+	class SweptAABBBatch
+	{
+
+	public:
+
+		// Implementations of the swept AABB test
+		enum class Kernel { SCALAR, SSE2, AVX2 };
+
+		// Constructor
+		SweptAABBBatch() : m_Size(0) { }
+
+		// Removes all candidates (keeps the memory for the next batch)
+		inline void Clear() { m_X1.clear(); m_X2.clear(); m_Y1.clear(); m_Y2.clear(); m_GameObjects.clear(); m_Size = 0; }
+
+		// Adds the AABB of a game object as a candidate
+		void Add(const aabb2Df& aabb, GameObject* gameObject);
+
+		// Gets the number of candidates
+		inline size_t size() const { return m_Size; }
+
+		// Gets the AABB of a candidate
+		inline aabb2Df aabb(size_t index) const { return aabb2Df(m_X1[index], m_X2[index], m_Y1[index], m_Y2[index]); }
+
+		// Gets the game object of a candidate
+		inline GameObject* gameObject(size_t index) const { return m_GameObjects[index]; }
+
+		// Finds the first candidate hit by an AABB moving along the specified motion (returns NULL if no candidate is hit)
+		//		NOTE: like testing the candidates one at a time, the candidate
+		//		with the lowest progression is hit, and the candidate added first
+		//		is hit when multiple candidates are hit at the same progression.
+		//		Hits at the end of the motion (progression 1) are not reported.
+		//		The position, normal and progression are only written on a hit.
+		GameObject* FindFirst(const aabb2Df& aabb, const f2& motion, f2& out_Position, f2& out_Normal, float& out_Progression) const;
+
+		// Gets the kernel that is used for testing candidates
+		static inline Kernel GetKernel() { return s_Kernel; }
+
+		// Selects the kernel that is used for testing candidates (returns false if the CPU does not support it)
+		//		NOTE: the kernel is shared by all threads, so it should only be
+		//		changed while no candidates are being tested.
+		static bool SetKernel(Kernel kernel);
+
+		// Checks whether the CPU supports a kernel
+		static bool IsSupported(Kernel kernel);
+
+	private:
+
+		// Candidate AABBs (padded to a multiple of the widest kernel, so kernels can load whole packets)
+		std::vector<float> m_X1;
+		std::vector<float> m_X2;
+		std::vector<float> m_Y1;
+		std::vector<float> m_Y2;
+
+		// Game objects of the candidates
+		std::vector<GameObject*> m_GameObjects;
+
+		// Number of candidates
+		size_t m_Size;
+
+		// Number of candidates tested at a time by the widest kernel
+		static const size_t s_PacketSize;
+
+		// Kernel that is used for testing candidates
+		static Kernel s_Kernel;
+
+		// Finds the index of the first candidate hit by the moving AABB (returns the number of candidates if no candidate is hit)
+		size_t FindFirstScalar(const aabb2Df& aabb, const f2& motion) const;
+		size_t FindFirstSSE2(const aabb2Df& aabb, const f2& motion) const;
+		size_t FindFirstAVX2(const aabb2Df& aabb, const f2& motion) const;
+
+		// Selects the widest kernel the CPU supports
+		static Kernel SelectKernel();
+
+	};
+}
+
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+#ifndef ENGINE_WORLD_WORLDCOMMANDBUFFER_H
+#define ENGINE_WORLD_WORLDCOMMANDBUFFER_H
+
+#include "GameObjectHandle.hpp" // For referring to game objects that should be removed
+
+#include <vector> // For holding the recorded commands
+#include <functional> // For recording deferred writes to other game objects
+
+namespace Engine{
+
+	class GameObject;
+
+	// Mutation of the game world that is recorded during a parallel update
+	struct WorldCommand
+	{
+		// Types of world commands
+		enum class Type
+		{
+			ADD,		// Add a game object to the world
+			REMOVE,		// Remove a game object from the world
+			DEFERRED	// Run a deferred function (e.g. a write to another game object)
+		};
+
+		Type m_Type;
+		GameObject* m_GameObject;
+		GameObjectHandle m_Handle;
+		std::function<void()> m_Function;
+	};
+
+	// Per-thread buffer of world mutations that are applied at the end of a parallel update (in recording order)
+	class WorldCommandBuffer
+	{
+
+	public:
+
+		// Records adding a game object to the world
+		inline void Add(GameObject* gameObject) { WorldCommand c = { WorldCommand::Type::ADD, gameObject, GameObjectHandle(), nullptr }; m_Commands.push_back(c); }
+
+		// Records removing a game object from the world
+		inline void Remove(GameObjectHandle handle) { WorldCommand c = { WorldCommand::Type::REMOVE, NULL, handle, nullptr }; m_Commands.push_back(c); }
+
+		// Records a deferred function
+		inline void Defer(const std::function<void()>& function) { WorldCommand c = { WorldCommand::Type::DEFERRED, NULL, GameObjectHandle(), function }; m_Commands.push_back(c); }
+
+		// Gets the recorded commands
+		inline const std::vector<WorldCommand>& commands() const { return m_Commands; }
+
+		// Clears all recorded commands (keeps the capacity for the next update)
+		inline void Clear() { m_Commands.clear(); }
+
+	private:
+
+		// Recorded commands
+		std::vector<WorldCommand> m_Commands;
+
+	};
+}
+
+#endif
@@ -2,15 +2,34 @@
 
 #include "../graphics/GraphicsManager.hpp" // For rendering object bounding boxes
 #include "../world/CollisionManager.hpp" // For querying objects by intersection
+#include "../jobs/JobManager.hpp" // For updating game objects in parallel
+#include "../timing/TimingManager.hpp" // For listening to alarms that wake up game objects
 
-#include <limits> // For initializing to the largest possible float value in NN and kNN search
-#include <list> // For storing the k nearest neighbors to a point (constant time random insertion)
+#include <algorithm> // For grouping batches of spawned game objects by type, and for sorting the draw list
 
 // Initializes the game world
 void Engine::WorldManager::Initialize()
 {
 	// Initialize the handles counter at zero
 	m_Handles = 0;
+
+	// Update game objects serially by default
+	m_ParallelUpdate = false;
+
+	// Start with an empty draw list
+	m_AddedGameObjects = 0;
+	m_DrawFrame = 1;
+
+	// Start updating at the first bucket of every update tier
+	m_UpdateFrame = 0;
+
+	// Reserve the spawn and removal queues up front
+	m_Updating = false;
+	m_Spawning = false;
+	m_SpawnQueue.reserve(s_InitialQueueCapacity);
+	m_SpawnBatch.reserve(s_InitialQueueCapacity);
+	m_GameObjectRemoveList.reserve(s_InitialQueueCapacity);
+	m_GameObjectRemoveBatch.reserve(s_InitialQueueCapacity);
 }
 
 // Destroys the game world
@@ -22,21 +41,164 @@ void Engine::WorldManager::Terminate()
 // Updates all game objects in the game world
 void Engine::WorldManager::Update(const GameTime& gameTime)
 {
-	for (std::pair<GameObjectGUID, GameObject*> gameObject : m_GameObjects)
+	// Queue game objects that are added while updating
+	m_Updating = true;
+
+	// Rebuild the static geometry if static game objects were added or removed in between updates
+	CollisionManager::GetInstance().BakeStaticGeometry();
+
+	// Update the bucket of every update tier that is due this frame (sleeping game objects are not in any tier)
+	for (auto& tier : m_UpdateTiers)
 	{
-		gameObject.second->Update(gameTime);
+		const std::vector<GameObject*>& gameObjects = tier.second.m_Buckets[m_UpdateFrame % tier.first];
+		if (gameObjects.empty()) { continue; }
+
+		GameTime tierTime = (tier.first == 1) ? gameTime : gameTime.accumulated(tier.first);
+		if (m_ParallelUpdate) { UpdateParallel(tierTime, gameObjects); }
+		else { for (GameObject* gameObject : gameObjects) { gameObject->Update(tierTime); } }
 	}
+	m_UpdateFrame++;
+
+	// Move the registered game objects in a single pass
+	if (!m_Movers.empty()) { MoveAll2D(gameTime); }
+	m_Updating = false;
+
+	// Add objects that have been spawned during the update in bulk
+	SpawnQueuedGameObjects();
+
+	// Put game objects to sleep, wake them up, and move them between update tiers
+	ApplyQueuedActivityChanges();
 
 	// Remove objects that have been marked for removal
 	RemoveMarkedGameObjects();
+
+	// Recalculate the world AABBs of all moved objects in a single pass
+	m_GameObjectData.UpdateAABBs();
+	CollisionManager::GetInstance().SyncProxies(m_GameObjectData);
+
+	// Report the contacts between the game objects after they moved
+	CollisionManager::GetInstance().UpdateContacts(m_GameObjectData);
 }
 
-// Draws all game objects in the game world
+// Draws all game objects that are visible through the camera (in z order)
 void Engine::WorldManager::Draw(const GameTime& gameTime)
 {
-	for (std::pair<GameObjectGUID, GameObject*> gameObject : m_GameObjects)
+	// Pick up game objects that moved after the update
+	m_GameObjectData.UpdateAABBs();
+	CollisionManager::GetInstance().SyncProxies(m_GameObjectData);
+
+	// Keep the game objects that were visible in the previous frame in their order, and collect the newly visible ones separately
+	m_DrawFrame++;
+	m_NewlyVisible.clear();
+	CollisionManager::GetInstance().QueryOverlap(GraphicsManager::GetInstance().GetCameraView(), CollisionFilter::All(), [&](GameObject* gameObject)
+	{
+		if (gameObject->m_DrawFrame != m_DrawFrame - 1) { m_NewlyVisible.push_back(gameObject); }
+		gameObject->m_DrawFrame = m_DrawFrame;
+	});
+
+	// Drop the game objects that are no longer visible or have been removed
+	size_t visible = 0;
+	for (GameObject* gameObject : m_DrawList)
+	{
+		if (gameObject != NULL && gameObject->m_DrawFrame == m_DrawFrame) { m_DrawList[visible++] = gameObject; }
+	}
+	m_DrawList.resize(visible);
+
+	// Restore the order of the game objects that stay visible (only game objects that changed depth break the order of the previous frame)
+	if (!std::is_sorted(m_DrawList.begin(), m_DrawList.end(), IsDrawnBefore)) { std::sort(m_DrawList.begin(), m_DrawList.end(), IsDrawnBefore); }
+
+	// Sort the newly visible game objects on their own, and merge them into the draw order
+	std::sort(m_NewlyVisible.begin(), m_NewlyVisible.end(), IsDrawnBefore);
+	size_t retained = m_DrawList.size();
+	m_DrawList.insert(m_DrawList.end(), m_NewlyVisible.begin(), m_NewlyVisible.end());
+	std::inplace_merge(m_DrawList.begin(), m_DrawList.begin() + retained, m_DrawList.end(), IsDrawnBefore);
+
+	for (size_t i = 0; i < m_DrawList.size(); i++)
 	{
-		gameObject.second->Draw(gameTime);
+		m_DrawList[i]->m_DrawIndex = i;
+		m_DrawList[i]->Draw(gameTime);
+	}
+}
+
+////////////////////////////////////////////////////////////////
+// Parallel update                                            //
+////////////////////////////////////////////////////////////////
+
+// Enables or disables updating game objects on the threads of the job manager
+void Engine::WorldManager::SetParallelUpdate(bool enabled)
+{
+	m_ParallelUpdate = enabled;
+}
+
+// Defers a function until the end of the parallel update (e.g. for writing to other game objects), or runs it immediately outside of parallel updates
+void Engine::WorldManager::Defer(const std::function<void()>& function)
+{
+	if (s_CommandBuffer != NULL) { s_CommandBuffer->Defer(function); return; }
+	function();
+}
+
+// Updates a group of game objects on the threads of the job manager
+void Engine::WorldManager::UpdateParallel(const GameTime& gameTime, const std::vector<GameObject*>& gameObjects)
+{
+	// Recalculate all world AABBs before every tier, so game objects read each other's AABBs without recalculating them (see GameObject::aabb2D_world_uncached())
+	m_GameObjectData.UpdateAABBs();
+
+	// Split the game objects into thread-safe and serially updated game objects
+	m_ParallelGameObjects.clear();
+	m_SerialGameObjects.clear();
+	for (GameObject* gameObject : gameObjects)
+	{ 
+		if (gameObject->IsThreadSafe()) { m_ParallelGameObjects.push_back(gameObject); }
+		else { m_SerialGameObjects.push_back(gameObject); }
+	}
+
+	// Update the thread-safe game objects in ranges (each range records into the command buffer of the thread running it)
+	JobManager& jobs = JobManager::GetInstance();
+	if (m_CommandBuffers.size() < jobs.GetThreadCount()) { m_CommandBuffers.resize(jobs.GetThreadCount()); }
+
+	// Keep the data of all game objects in place while they are being updated
+	m_GameObjectData.BeginDeferredFree();
+	jobs.ParallelFor(0, m_ParallelGameObjects.size(), [&](size_t begin, size_t end)
+	{
+		WorldCommandBuffer* previous = s_CommandBuffer;
+		s_CommandBuffer = &m_CommandBuffers[JobManager::GetThreadIndex()];
+		for (size_t i = begin; i < end; i++) { m_ParallelGameObjects[i]->Update(gameTime); }
+		s_CommandBuffer = previous;
+	});
+	m_GameObjectData.EndDeferredFree();
+
+	// Sync point: apply the world mutations recorded during the parallel phase
+	ApplyCommandBuffers();
+
+	// Move the proxies of the game objects that moved during the parallel phase
+	m_GameObjectData.UpdateAABBs();
+	CollisionManager::GetInstance().SyncProxies(m_GameObjectData);
+
+	// Update the game objects that opted out of parallel updates
+	for (GameObject* gameObject : m_SerialGameObjects) { gameObject->Update(gameTime); }
+}
+
+// Applies the world mutations recorded by all threads (in thread order)
+void Engine::WorldManager::ApplyCommandBuffers()
+{
+	for (WorldCommandBuffer& buffer : m_CommandBuffers)
+	{
+		for (const WorldCommand& command : buffer.commands())
+		{
+			switch (command.m_Type)
+			{
+			case WorldCommand::Type::ADD:
+				m_SpawnQueue.push_back(command.m_GameObject);
+				break;
+			case WorldCommand::Type::REMOVE:
+				m_GameObjectRemoveList.push_back(command.m_Handle);
+				break;
+			case WorldCommand::Type::DEFERRED:
+				command.m_Function();
+				break;
+			}
+		}
+		buffer.Clear();
 	}
 }
 
@@ -45,406 +207,616 @@ void Engine::WorldManager::Draw(const GameTime& gameTime)
 ////////////////////////////////////////////////////////////////
 
 // Adds a game object to the world and returns the handle
-Engine::GameObjectGUID Engine::WorldManager::AddGameObject(GameObject* gameObject)
+Engine::GameObjectHandle Engine::WorldManager::AddGameObject(GameObject* gameObject)
 {
+	// Move the data of the object into the store (this assigns its handle, the object is not added if the store is full)
+	if (!m_GameObjectData.Allocate(gameObject)) { return GameObjectHandle(); }
+
+	// Defer adding the object while updating in parallel
+	if (s_CommandBuffer != NULL) { s_CommandBuffer->Add(gameObject); return gameObject->handle(); }
+
+	// Queue the object while the world is updating (or while a batch of queued objects is added)
+	if (m_Updating || m_Spawning) { m_SpawnQueue.push_back(gameObject); return gameObject->handle(); }
+
 	// Initialize the object and add it to the game world
 	gameObject->Create();
-	m_GameObjects.insert(std::pair<GameObjectGUID, GameObject*>(gameObject->guid(), gameObject));
-	AddToByTypeMap(gameObject);
+	AddToTypeIndex(gameObject);
+	AddToBroadphase(gameObject);
+	gameObject->SetFlag(FLAG_IN_WORLD, true);
+	if (!gameObject->m_Sleeping) { AddToUpdateTier(gameObject); }
 
-	return gameObject->guid();
+	return gameObject->handle();
 }
 
 // Adds a group of game objects to the world 
 void Engine::WorldManager::AddGameObjects(const GameObjectCollection& gameObjects)
 {
-	for (GameObject* object : gameObjects.objects()) 
-	{ 
-		object->Create();
-		m_GameObjects.insert(std::pair<GameObjectGUID, GameObject*>(object->guid(), object));
-		AddToByTypeMap(object);
+	// Only add the objects that fit in the store
+	std::vector<GameObject*> batch;
+	batch.reserve(gameObjects.objects().size());
+	for (GameObject* object : gameObjects.objects()) { if (m_GameObjectData.Allocate(object)) { batch.push_back(object); } }
+	if (s_CommandBuffer != NULL) { for (GameObject* object : batch) { s_CommandBuffer->Add(object); } return; }
+	if (m_Updating || m_Spawning) { m_SpawnQueue.insert(m_SpawnQueue.end(), batch.begin(), batch.end()); return; }
+
+	AddGameObjectBatch(batch);
+}
+
+// Reserves capacity for holding at least the specified number of game objects, and for spawning and removing them in bulk
+void Engine::WorldManager::ReserveGameObjects(size_t capacity)
+{
+	m_GameObjectData.Reserve(capacity);
+	m_SpawnQueue.reserve(capacity);
+	m_SpawnBatch.reserve(capacity);
+	m_GameObjectRemoveList.reserve(capacity);
+	m_GameObjectRemoveBatch.reserve(capacity);
+}
+
+// Retrieves the allocation statistics of all game object pools
+void Engine::WorldManager::RetrievePoolStats(std::vector<GameObjectPoolStats>& out_Stats) const
+{
+	std::lock_guard<std::mutex> lock(m_PoolsMutex);
+	for (auto& pool : m_Pools) { out_Stats.push_back(pool.second->stats()); }
+}
+
+// Adds a batch of game objects to the world (creates them grouped by type)
+void Engine::WorldManager::AddGameObjectBatch(std::vector<GameObject*>& gameObjects)
+{
+	// Group the game objects by type (keeping the spawn order within each type)
+	std::stable_sort(gameObjects.begin(), gameObjects.end(), [](GameObject* a, GameObject* b) { return a->type() < b->type(); });
+
+	// Create and index the game objects one type at a time (looks up the by-type index once per type)
+	for (size_t begin = 0; begin < gameObjects.size();)
+	{
+		GameObjectType type = gameObjects[begin]->type();
+		size_t end = begin + 1;
+		while (end < gameObjects.size() && gameObjects[end]->type() == type) { end++; }
+
+		for (size_t i = begin; i < end; i++) { gameObjects[i]->Create(); }
+		std::vector<GameObject*>& gameObjectsOfType = GetTypeIndex(type);
+		gameObjectsOfType.reserve(gameObjectsOfType.size() + (end - begin));
+		for (size_t i = begin; i < end; i++)
+		{
+			gameObjects[i]->m_TypeIndex = gameObjectsOfType.size();
+			gameObjectsOfType.push_back(gameObjects[i]);
+			AddToBroadphase(gameObjects[i]);
+			gameObjects[i]->SetFlag(FLAG_IN_WORLD, true);
+			if (!gameObjects[i]->m_Sleeping) { AddToUpdateTier(gameObjects[i]); }
+		}
+
+		begin = end;
+	}
+}
+
+// Adds all game objects that are queued to be added to the world
+void Engine::WorldManager::SpawnQueuedGameObjects()
+{
+	// Swap the queue out, so game objects spawned from Create() are queued for the next batch
+	m_Spawning = true;
+	while (!m_SpawnQueue.empty())
+	{
+		m_SpawnBatch.swap(m_SpawnQueue);
+		AddGameObjectBatch(m_SpawnBatch);
+		m_SpawnBatch.clear();
 	}
+	m_Spawning = false;
 }
 
 // Removes a game object from the world (based on its pointer)
 void Engine::WorldManager::RemoveGameObject(GameObject* gameObject)
 {
-	m_GameObjectRemoveList.push_back(gameObject->guid());
+	RemoveGameObject(gameObject->handle());
+}
+
+// Removes a game object from the world (based on its handle)
+void Engine::WorldManager::RemoveGameObject(GameObjectHandle handle)
+{
+	if (s_CommandBuffer != NULL) { s_CommandBuffer->Remove(handle); return; }
+	m_GameObjectRemoveList.push_back(handle);
 }
 
 // Removes a group of game objects from the world
 void Engine::WorldManager::RemoveGameObjects(const GameObjectCollection& gameObjects)
 {
-	// Add the game object GUIDs to the remove list
-	for (GameObject* object : gameObjects.objects()) { m_GameObjectRemoveList.push_back(object->guid()); }
+	// Add the game object handles to the remove list
+	for (GameObject* object : gameObjects.objects()) { RemoveGameObject(object->handle()); }
 }
 
 ////////////////////////////////////////////////////////////////
-// Game object retrieval									  //
+// Collision-aware movement		                              //
 ////////////////////////////////////////////////////////////////
 
-// Retrieves all game objects
-size_t Engine::WorldManager::RetrieveAll(GameObjectCollection& out_GameObjectCollection) const
+// Finds the first candidate hit by a moving game object, testing the colliders of both (returns NULL if no candidate is hit)
+Engine::GameObject* Engine::WorldManager::FindFirstShape2D(GameObject& gameObject, const SweptAABBBatch& candidates, const f2& motion, f2& out_Position, f2& out_Normal, float& out_Progression)
 {
-	size_t count = 0;
-	for (auto o : m_GameObjects) { out_GameObjectCollection.objects().insert(o.second); count++; }
-	return count;
+	const aabb2Df& aabb = gameObject.aabb2D_world();
+	GameObject* first = NULL;
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		GameObject* candidate = candidates.gameObject(i);
+		const Collider& collider = candidate->m_Static ? s_StaticCollider : candidate->m_Collider;
+
+		f2 position, normal;
+		float progression;
+		if (!CollisionManager::IsIntersecting(gameObject.m_Collider, aabb, collider, candidates.aabb(i), motion, position, normal, progression)) { continue; }
+		if (progression >= out_Progression) { continue; }
+		out_Position = position;
+		out_Normal = normal;
+		out_Progression = progression;
+		first = candidate;
+	}
+	return first;
 }
 
-// Retrieves the game object that matches the specified GUID
-size_t Engine::WorldManager::RetrieveByGUID(GameObjectGUID guid, GameObjectCollection& out_GameObjectCollection) const
+////////////////////////////////////////////////////////////////
+// Batched movement                                           //
+////////////////////////////////////////////////////////////////
+
+// Registers a game object to be moved by its velocity every frame, resolving collisions with the game objects that match the filter
+void Engine::WorldManager::RegisterMover(GameObjectHandle handle, CollisionResponse response, const CollisionFilter& filter, bool updateVelocity)
 {
-	auto object = m_GameObjects.find(guid);
-	if (object == m_GameObjects.end()) { return size_t(0); }
-	out_GameObjectCollection.objects().insert(object->second);
-	return size_t(1);
+	Defer([this, handle, response, filter, updateVelocity]()
+	{
+		// Check if the game object still exists (stale handles do not resolve)
+		GameObject* gameObject = m_GameObjectData.Resolve(handle);
+		if (gameObject == NULL) { return; }
+
+		Mover mover = { gameObject, response, filter, updateVelocity };
+		if (gameObject->m_Moving) { m_Movers[gameObject->m_MoverIndex] = mover; return; }
+		gameObject->m_Moving = true;
+		gameObject->m_MoverIndex = m_Movers.size();
+		m_Movers.push_back(mover);
+	});
 }
 
-// Retrieves all game objects that matchs the specified type
-size_t Engine::WorldManager::RetrieveByType(GameObjectType type, GameObjectCollection& out_GameObjectCollection) const
+// Stops moving a game object every frame
+void Engine::WorldManager::UnregisterMover(GameObjectHandle handle)
 {
-	if (type == OBJ_INVALID) { return size_t(0); }
-	if (type == OBJ_ANY) { return RetrieveAll(out_GameObjectCollection); }
-
-	size_t count = 0;
-	auto objects = m_GameObjectsByType.find(type);
-	if (objects == m_GameObjectsByType.end()) { return size_t(0); }
-	for (auto o : objects->second) { out_GameObjectCollection.objects().insert(o); count++; }
-	return count;
+	Defer([this, handle]()
+	{
+		GameObject* gameObject = m_GameObjectData.Resolve(handle);
+		if (gameObject != NULL && gameObject->m_Moving) { RemoveMover(gameObject); }
+	});
 }
 
-////////////////////////////////////////////////////////////////
-// Position-based game object retrieval                       //
-////////////////////////////////////////////////////////////////
-
-// Retrieves the nearest game object to the specified position considering x and y coordinates (returns whether a game object was found)
-bool Engine::WorldManager::RetrieveNearestGameObject(const f2& position, GameObject*& out_GameObject, GameObjectType typeFilter)
+// Removes a game object from the movers (moves the last mover into its place)
+void Engine::WorldManager::RemoveMover(GameObject* gameObject)
 {
-	// Linear search nearest neighbor
-	// TODO: this is slow, accelerate this using a dedicated data structure
-	// http://en.wikipedia.org/wiki/Nearest_neighbor_search
-
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
+	size_t index = gameObject->m_MoverIndex;
+	m_Movers[index] = m_Movers.back();
+	m_Movers[index].m_GameObject->m_MoverIndex = index;
+	m_Movers.pop_back();
+	gameObject->m_Moving = false;
+}
 
-	float smallestDistance = std::numeric_limits<float>::max();
-	GameObject* closestGameObject = NULL; 
+// Moves all registered game objects by their velocity, resolving collisions in a single pass over the broadphase
+void Engine::WorldManager::MoveAll2D(const GameTime& gameTime)
+{
+	// Pick up the game objects that moved during the update, so every mover starts from its current AABB
+	CollisionManager& collision = CollisionManager::GetInstance();
+	m_GameObjectData.UpdateAABBs();
+	collision.SyncProxies(m_GameObjectData);
+
+	// Enlarge the proxy of every mover to the area it can reach this frame (each solver iteration can add the separation distance)
+	float deltaTime = gameTime.GetDeltaTimeSeconds();
+	m_MoverMotion.resize(m_Movers.size());
+	m_MoverReach.resize(m_Movers.size());
+	for (size_t i = 0; i < m_Movers.size(); i++)
+	{
+		if (!IsMoving(m_Movers[i])) { continue; }
+		GameObject* gameObject = m_Movers[i].m_GameObject;
+		m_MoverMotion[i] = gameObject->velocity2D() * deltaTime;
+		float reach = m_MoverMotion[i].length() + s_ObjectSeparationDistance * s_MaxMovementIterations;
+		const aabb2Df& aabb = gameObject->aabb2D_world();
+		m_MoverReach[i] = aabb2Df(aabb.x1() - reach, aabb.x2() + reach, aabb.y1() - reach, aabb.y2() + reach);
+		collision.ReserveProxy(gameObject, m_MoverReach[i]);
+	}
 
-	if (typeFilter == OBJ_ANY)
+	// Resolve the movers in registration order
+	if (!m_ParallelUpdate)
 	{
-		for (auto gameObject : m_GameObjects)
+		for (size_t i = 0; i < m_Movers.size(); i++)
 		{
-			float distance = gameObject.second->t().xy().distance(position);
-			if (distance < smallestDistance)
-			{
-				smallestDistance = distance;
-				closestGameObject = gameObject.second;
-			}
+			if (IsMoving(m_Movers[i])) { Solve2D(*m_Movers[i].m_GameObject, m_MoverMotion[i], m_Movers[i].m_Response, m_Movers[i].m_Filter, m_Movers[i].m_UpdateVelocity); }
 		}
 	}
+
+	// Resolve islands of movers that can reach each other on different threads (in registration order within each island)
 	else
 	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
+		size_t islands = BuildMoverIslands();
+		JobManager& jobs = JobManager::GetInstance();
+		if (m_CommandBuffers.size() < jobs.GetThreadCount()) { m_CommandBuffers.resize(jobs.GetThreadCount()); }
+
+		m_GameObjectData.BeginDeferredFree();
+		jobs.ParallelFor(0, islands, [&](size_t begin, size_t end)
 		{
-			float distance = gameObject->t2D().distance(position);
-			if (distance < smallestDistance)
+			WorldCommandBuffer* previous = s_CommandBuffer;
+			s_CommandBuffer = &m_CommandBuffers[JobManager::GetThreadIndex()];
+			for (size_t i = m_MoverIslandOffsets[begin]; i < m_MoverIslandOffsets[end]; i++)
 			{
-				smallestDistance = distance;
-				closestGameObject = gameObject;
+				const Mover& mover = m_Movers[m_MoverIslandOrder[i]];
+				Solve2D(*mover.m_GameObject, m_MoverMotion[m_MoverIslandOrder[i]], mover.m_Response, mover.m_Filter, mover.m_UpdateVelocity);
 			}
-		}
+			s_CommandBuffer = previous;
+		});
+		m_GameObjectData.EndDeferredFree();
+		ApplyCommandBuffers();
 	}
 
-	if (closestGameObject == NULL) { return false; }
-
-	out_GameObject = closestGameObject;
-	return true;
+	// Move the positions of the movers in the position tree (the movers stayed within their proxies)
+	m_GameObjectData.UpdateAABBs();
+	collision.SyncProxies(m_GameObjectData);
 }
 
-// Retrieves the nearest game object to the specified position considering x, y and z coordinates (returns whether a game object was found)
-bool Engine::WorldManager::RetrieveNearestGameObject(const f3& position, GameObject*& out_GameObject, GameObjectType typeFilter)
+// Splits the movers into islands of movers that can reach each other (returns the number of islands)
+size_t Engine::WorldManager::BuildMoverIslands()
 {
-	// Linear search nearest neighbor
-	// TODO: this is slow, accelerate this using a dedicated data structure
-	// http://en.wikipedia.org/wiki/Nearest_neighbor_search
-
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
-
-	float smallestDistance = std::numeric_limits<float>::max();
-	GameObject* closestGameObject = NULL;
-
-	if (typeFilter == OBJ_ANY)
+	// Join every mover with the movers whose proxies overlap with its proxy (a mover only finds game objects within its proxy while it is resolved)
+	CollisionManager& collision = CollisionManager::GetInstance();
+	m_MoverIslandParent.resize(m_Movers.size());
+	for (size_t i = 0; i < m_Movers.size(); i++) { m_MoverIslandParent[i] = i; }
+	for (size_t i = 0; i < m_Movers.size(); i++)
 	{
-		for (auto gameObject : m_GameObjects)
+		if (!IsMoving(m_Movers[i])) { continue; }
+		collision.QueryProxies(collision.GetProxyAABB(m_Movers[i].m_GameObject), [&](GameObject* gameObject)
 		{
-			float distance = gameObject.second->t().distance(position);
-			if (distance < smallestDistance)
-			{
-				smallestDistance = distance;
-				closestGameObject = gameObject.second;
-			}
-		}
+			if (!gameObject->m_Moving || !IsMoving(m_Movers[gameObject->m_MoverIndex])) { return; }
+			size_t a = FindMoverIsland(i);
+			size_t b = FindMoverIsland(gameObject->m_MoverIndex);
+			if (a == b) { return; }
+
+			// Keep the earliest mover as the root, so islands are numbered the same way every time
+			if (a < b) { m_MoverIslandParent[b] = a; }
+			else { m_MoverIslandParent[a] = b; }
+		});
 	}
-	else
+
+	// Number the islands in the order of their earliest mover, and count the movers of every island
+	m_MoverIsland.resize(m_Movers.size());
+	m_MoverIslandOffsets.assign(1, 0);
+	for (size_t i = 0; i < m_Movers.size(); i++)
 	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
-		{
-			float distance = gameObject->t().distance(position);
-			if (distance < smallestDistance)
-			{
-				smallestDistance = distance;
-				closestGameObject = gameObject;
-			}
-		}
+		if (!IsMoving(m_Movers[i])) { continue; }
+		size_t root = FindMoverIsland(i);
+		if (root == i) { m_MoverIsland[i] = m_MoverIslandOffsets.size() - 1; m_MoverIslandOffsets.push_back(0); }
+		else { m_MoverIsland[i] = m_MoverIsland[root]; }
+		m_MoverIslandOffsets[m_MoverIsland[i] + 1]++;
 	}
-	
+	size_t islands = m_MoverIslandOffsets.size() - 1;
 
-	if (closestGameObject == NULL) { return false; }
+	// Order the movers by island (keeping the registration order within every island)
+	for (size_t island = 0; island < islands; island++) { m_MoverIslandOffsets[island + 1] += m_MoverIslandOffsets[island]; }
+	m_MoverIslandOrder.resize(m_MoverIslandOffsets[islands]);
+	m_MoverIslandInsert.assign(m_MoverIslandOffsets.begin(), m_MoverIslandOffsets.end() - 1);
+	for (size_t i = 0; i < m_Movers.size(); i++)
+	{
+		if (IsMoving(m_Movers[i])) { m_MoverIslandOrder[m_MoverIslandInsert[m_MoverIsland[i]]++] = i; }
+	}
 
-	out_GameObject = closestGameObject;
-	return true;
+	return islands;
 }
 
-// Retrieves the k-nearest game object to the specified position considering x and y coordinates (returns the number of game objects found)
-size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f2& position, size_t k, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+////////////////////////////////////////////////////////////////
+// Game object activity                                       //
+////////////////////////////////////////////////////////////////
+
+// Puts a game object to sleep (sleeping game objects are still drawn, but are not updated until woken up)
+void Engine::WorldManager::SleepGameObject(GameObjectHandle handle)
 {
-	// Linear search nearest neighbor
-	// TODO: this is slow, accelerate this using a dedicated data structure
-	// TODO: replace naive kNN implementation (better to quicksort and pick top k?)
+	ActivityChange change = { ActivityChange::Type::SLEEP, handle, 0 };
+	ChangeActivity(change);
+}
 
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
+// Wakes up a sleeping game object
+void Engine::WorldManager::WakeGameObject(GameObjectHandle handle)
+{
+	ActivityChange change = { ActivityChange::Type::WAKE, handle, 0 };
+	ChangeActivity(change);
+}
 
-	struct GameObjectDistance
-	{
-		GameObject* m_GameObject;
-		float m_Distance;
-	};
+// Wakes up a game object when an alarm of the timing manager goes off
+void Engine::WorldManager::WakeGameObjectOnAlarm(GameObjectHandle handle, AlarmID alarmID)
+{
+	// Defer waiting for the alarm while updating in parallel
+	if (s_CommandBuffer != NULL) { s_CommandBuffer->Defer([this, handle, alarmID]() { WakeGameObjectOnAlarm(handle, alarmID); }); return; }
 
-	std::list<GameObjectDistance> nearestGameObjects;
-	
-	if (typeFilter == OBJ_ANY)
+	// Listen to the alarm when the first game object starts waiting for it
+	auto wakeUps = m_AlarmWakeUps.find(alarmID);
+	if (wakeUps == m_AlarmWakeUps.end())
 	{
-		for (auto gameObject : m_GameObjects)
-		{
-			// Iteratively insert elements in the correct order (elements are sorted in large-to-small distance)
-			GameObjectDistance gameObjectDistanceNew;
-			gameObjectDistanceNew.m_GameObject = gameObject.second;
-			gameObjectDistanceNew.m_Distance = gameObject.second->t2D().distance(position);
-
-			bool inserted = false;
-			for (auto gameObjectDistanceIt = nearestGameObjects.begin(); gameObjectDistanceIt != nearestGameObjects.end(); gameObjectDistanceIt++)
-			{
-				if (gameObjectDistanceNew.m_Distance > gameObjectDistanceIt->m_Distance)
-				{
-					nearestGameObjects.insert(gameObjectDistanceIt, gameObjectDistanceNew);
-					inserted = true;
-					break;
-				}
-			}
-			if (!inserted) { nearestGameObjects.push_back(gameObjectDistanceNew); }
-
-			// Cap the list at k element
-			if (nearestGameObjects.size() > k) { nearestGameObjects.pop_front(); }
-		}
+		TimingManager::GetInstance().RegisterAlarmListener(alarmID, this);
+		wakeUps = m_AlarmWakeUps.insert(std::pair<AlarmID, std::vector<GameObjectHandle>>(alarmID, std::vector<GameObjectHandle>())).first;
 	}
-	else
-	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
-		{
-			// Iteratively insert elements in the correct order (elements are sorted in large-to-small distance)
-			GameObjectDistance gameObjectDistanceNew;
-			gameObjectDistanceNew.m_GameObject = gameObject;
-			gameObjectDistanceNew.m_Distance = gameObject->t2D().distance(position);
-
-			bool inserted = false;
-			for (auto gameObjectDistanceIt = nearestGameObjects.begin(); gameObjectDistanceIt != nearestGameObjects.end(); gameObjectDistanceIt++)
-			{
-				if (gameObjectDistanceNew.m_Distance > gameObjectDistanceIt->m_Distance)
-				{
-					nearestGameObjects.insert(gameObjectDistanceIt, gameObjectDistanceNew);
-					inserted = true;
-					break;
-				}
-			}
-			if (!inserted) { nearestGameObjects.push_back(gameObjectDistanceNew); }
+	wakeUps->second.push_back(handle);
+}
 
-			// Cap the list at k element
-			if (nearestGameObjects.size() > k) { nearestGameObjects.pop_front(); }
-		}
-	}
+// Sets the number of frames between updates of a game object (1 updates the game object every frame)
+void Engine::WorldManager::SetUpdateInterval(GameObjectHandle handle, unsigned int frames)
+{
+	ActivityChange change = { ActivityChange::Type::UPDATE_INTERVAL, handle, (frames == 0) ? 1 : frames };
+	ChangeActivity(change);
+}
 
-	// Copy over the top k elements
-	for (auto gameObjectDistanceIt = nearestGameObjects.rbegin(); gameObjectDistanceIt != nearestGameObjects.rend(); gameObjectDistanceIt++)
-	{
-		out_GameObjects.push_back(gameObjectDistanceIt->m_GameObject);
-	}
+// Wakes up the game objects waiting for an alarm
+void Engine::WorldManager::ProcessAlarmEvent(AlarmID alarmID, Timestamp timestamp)
+{
+	auto wakeUps = m_AlarmWakeUps.find(alarmID);
+	if (wakeUps == m_AlarmWakeUps.end()) { return; }
 
-	return nearestGameObjects.size();
+	// Stay registered, so game objects can wait for the next period of periodic alarms
+	std::vector<GameObjectHandle> handles;
+	handles.swap(wakeUps->second);
+	for (GameObjectHandle handle : handles) { WakeGameObject(handle); }
 }
 
-// Retrieves the k-nearest game object to the specified position considering x, y and z coordinates (returns the number of game objects found)
-size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f3& position, size_t k, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+// Changes the activity of a game object, or queues the change while updating
+void Engine::WorldManager::ChangeActivity(const ActivityChange& change)
 {
-	// Linear search nearest neighbor
-	// TODO: this is slow, accelerate this using a dedicated data structure
-	// TODO: replace naive kNN implementation (better to quicksort and pick top k?)
+	// Defer the change while updating in parallel
+	if (s_CommandBuffer != NULL) { s_CommandBuffer->Defer([this, change]() { ChangeActivity(change); }); return; }
 
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
+	// Queue the change while the world is updating (the update tiers are being iterated)
+	if (m_Updating) { m_ActivityQueue.push_back(change); return; }
 
-	struct GameObjectDistance
+	// Check if the game object still exists (stale handles do not resolve)
+	GameObject* gameObject = m_GameObjectData.Resolve(change.m_Handle);
+	if (gameObject == NULL) { return; }
+
+	bool sleeping = gameObject->m_Sleeping;
+	unsigned int updateInterval = gameObject->m_UpdateInterval;
+	switch (change.m_Type)
 	{
-		GameObject* m_GameObject;
-		float m_Distance;
-	};
+	case ActivityChange::Type::SLEEP:
+		sleeping = true;
+		break;
+	case ActivityChange::Type::WAKE:
+		sleeping = false;
+		break;
+	case ActivityChange::Type::UPDATE_INTERVAL:
+		updateInterval = change.m_UpdateInterval;
+		break;
+	}
+	if (sleeping == gameObject->m_Sleeping && updateInterval == gameObject->m_UpdateInterval) { return; }
+
+	// Move the game object between update tiers (game objects that are not in the world yet are placed once they are added)
+	bool inWorld = gameObject->HasFlag(FLAG_IN_WORLD);
+	if (inWorld && !gameObject->m_Sleeping) { RemoveFromUpdateTier(gameObject); }
+	gameObject->m_Sleeping = sleeping;
+	gameObject->m_UpdateInterval = updateInterval;
+	if (inWorld && !gameObject->m_Sleeping) { AddToUpdateTier(gameObject); }
+}
 
-	std::list<GameObjectDistance> nearestGameObjects;
+// Applies the activity changes that are queued during the update
+void Engine::WorldManager::ApplyQueuedActivityChanges()
+{
+	for (const ActivityChange& change : m_ActivityQueue) { ChangeActivity(change); }
+	m_ActivityQueue.clear();
+}
 
-	if (typeFilter == OBJ_ANY)
-	{
-		for (auto gameObject : m_GameObjects)
-		{
-			// Iteratively insert elements in the correct order (elements are sorted in large-to-small distance)
-			GameObjectDistance gameObjectDistanceNew;
-			gameObjectDistanceNew.m_GameObject = gameObject.second;
-			gameObjectDistanceNew.m_Distance = gameObject.second->t().distance(position);
+////////////////////////////////////////////////////////////////
+// Game object retrieval									  //
+////////////////////////////////////////////////////////////////
 
-			bool inserted = false;
-			for (auto gameObjectDistanceIt = nearestGameObjects.begin(); gameObjectDistanceIt != nearestGameObjects.end(); gameObjectDistanceIt++)
-			{
-				if (gameObjectDistanceNew.m_Distance > gameObjectDistanceIt->m_Distance)
-				{
-					nearestGameObjects.insert(gameObjectDistanceIt, gameObjectDistanceNew);
-					inserted = true;
-					break;
-				}
-			}
-			if (!inserted) { nearestGameObjects.push_back(gameObjectDistanceNew); }
+// Retrieves all game objects
+size_t Engine::WorldManager::RetrieveAll(GameObjectCollection& out_GameObjectCollection) const
+{
+	size_t count = 0;
+	ForEachGameObject([&](GameObject* gameObject) { out_GameObjectCollection.objects().insert(gameObject); count++; });
+	return count;
+}
 
-			// Cap the list at k element
-			if (nearestGameObjects.size() > k) { nearestGameObjects.pop_front(); }
-		}
-	}
-	else
-	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
-		{
-			// Iteratively insert elements in the correct order (elements are sorted in large-to-small distance)
-			GameObjectDistance gameObjectDistanceNew;
-			gameObjectDistanceNew.m_GameObject = gameObject;
-			gameObjectDistanceNew.m_Distance = gameObject->t().distance(position);
+// Retrieves the game object that matches the specified GUID or handle
+size_t Engine::WorldManager::RetrieveByGUID(GameObjectHandle handle, GameObjectCollection& out_GameObjectCollection) const
+{
+	GameObject* object = Retrieve(handle);
+	if (object == NULL) { return size_t(0); }
+	out_GameObjectCollection.objects().insert(object);
+	return size_t(1);
+}
 
-			bool inserted = false;
-			for (auto gameObjectDistanceIt = nearestGameObjects.begin(); gameObjectDistanceIt != nearestGameObjects.end(); gameObjectDistanceIt++)
-			{
-				if (gameObjectDistanceNew.m_Distance > gameObjectDistanceIt->m_Distance)
-				{
-					nearestGameObjects.insert(gameObjectDistanceIt, gameObjectDistanceNew);
-					inserted = true;
-					break;
-				}
-			}
-			if (!inserted) { nearestGameObjects.push_back(gameObjectDistanceNew); }
+// Retrieves all game objects that matchs the specified type
+size_t Engine::WorldManager::RetrieveByType(GameObjectType type, GameObjectCollection& out_GameObjectCollection) const
+{
+	if (type == OBJ_INVALID) { return size_t(0); }
+	if (type == OBJ_ANY) { return RetrieveAll(out_GameObjectCollection); }
 
-			// Cap the list at k element
-			if (nearestGameObjects.size() > k) { nearestGameObjects.pop_front(); }
-		}
-	}
+	GameObjectSpan objects = RetrieveByType(type);
+	out_GameObjectCollection.objects().insert(objects.begin(), objects.end());
+	return objects.size();
+}
 
-	// Copy over the top k elements
-	for (auto gameObjectDistanceIt = nearestGameObjects.rbegin(); gameObjectDistanceIt != nearestGameObjects.rend(); gameObjectDistanceIt++)
-	{
-		out_GameObjects.push_back(gameObjectDistanceIt->m_GameObject);
-	}
+// Retrieves all game objects that match the specified type, without copying them (returns an empty span for OBJ_ANY and OBJ_INVALID)
+Engine::GameObjectSpan Engine::WorldManager::RetrieveByType(GameObjectType type) const
+{
+	if (type == OBJ_INVALID || type == OBJ_ANY || type >= m_GameObjectsByType.size()) { return GameObjectSpan(); }
+	const std::vector<GameObject*>& objects = m_GameObjectsByType[type];
+	return GameObjectSpan(objects.data(), objects.size());
+}
 
-	return nearestGameObjects.size();
+// Creates a query over all game objects that match the specified type (OBJ_ANY queries all game objects in the world)
+Engine::GameObjectQuery Engine::WorldManager::Query(GameObjectType type) const
+{
+	if (type == OBJ_ANY) { return GameObjectQuery(m_GameObjectData); }
+	return GameObjectQuery(RetrieveByType(type));
 }
 
-// Retrieves all game objects closer than the specified distance to a point considering x and y coordinates (returns the number of game objects found)
-size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f2& position, float maxDistance, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+////////////////////////////////////////////////////////////////
+// Position-based game object retrieval                       //
+////////////////////////////////////////////////////////////////
+
+// Retrieves the nearest game object to the specified position considering x and y coordinates (returns whether a game object was found)
+bool Engine::WorldManager::RetrieveNearestGameObject(const f2& position, GameObject*& out_GameObject, GameObjectType typeFilter)
 {
-	// TODO: this is slow, accelerate this using a dedicated data structure
+	return RetrieveKNearestGameObjects(position, 1, &out_GameObject, typeFilter) == 1;
+}
 
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
+// Retrieves the nearest game object to the specified position considering x, y and z coordinates (returns whether a game object was found)
+bool Engine::WorldManager::RetrieveNearestGameObject(const f3& position, GameObject*& out_GameObject, GameObjectType typeFilter)
+{
+	return RetrieveKNearestGameObjects(position, 1, &out_GameObject, typeFilter) == 1;
+}
 
-	size_t count = 0;
+// Retrieves the k-nearest game objects to the specified position considering x and y coordinates, nearest first (returns the number of game objects written to the buffer)
+size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f2& position, size_t k, GameObject** out_GameObjects, GameObjectType typeFilter) const
+{
+	s_NearestHeap.Reset(k);
+	if (k == 0) { return size_t(0); }
 
-	if (typeFilter == OBJ_ANY)
+	// Scan the by-type index for types with few game objects, and search the position tree otherwise
+	GameObjectSpan gameObjectsOfType = RetrieveByType(typeFilter);
+	if (typeFilter != OBJ_ANY && gameObjectsOfType.size() <= s_NearestScanLimit)
 	{
-		for (auto gameObject : m_GameObjects)
+		for (GameObject* gameObject : gameObjectsOfType)
 		{
-			if (gameObject.second->t2D().distance(position) <= maxDistance)
-			{
-				out_GameObjects.push_back(gameObject.second);
-				count++;
-			}
+			f2 d(gameObject->t2D() - position);
+			s_NearestHeap.Offer(d * d, gameObject);
 		}
 	}
 	else
 	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
-		{
-			if (gameObject->t2D().distance(position) <= maxDistance)
-			{
-				out_GameObjects.push_back(gameObject);
-				count++;
-			}
-		}
+		CollisionFilter filter((typeFilter == OBJ_ANY) ? CollisionFilter::All() : CollisionFilter(typeFilter));
+		CollisionManager::GetInstance().QueryNearest(position, filter, s_NearestHeap);
 	}
-	
-	return count;
+
+	return s_NearestHeap.Write(out_GameObjects);
 }
 
-// Retrieves all game objects closer than the specified distance to a point considering x, y and z coordinates(returns the number of game objects found)
-size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f3& position, float maxDistance, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+// Retrieves the k-nearest game objects to the specified position considering x, y and z coordinates, nearest first (returns the number of game objects written to the buffer)
+size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f3& position, size_t k, GameObject** out_GameObjects, GameObjectType typeFilter) const
 {
-	// TODO: this is slow, accelerate this using a dedicated data structure
-	if (typeFilter != OBJ_ANY && m_GameObjectsByType.count(typeFilter) == 0) { return size_t(0); }
+	s_NearestHeap.Reset(k);
+	if (k == 0) { return size_t(0); }
 
-	size_t count = 0;
-
-	if (typeFilter == OBJ_ANY)
+	// Scan the by-type index for types with few game objects, and search the position tree otherwise
+	GameObjectSpan gameObjectsOfType = RetrieveByType(typeFilter);
+	if (typeFilter != OBJ_ANY && gameObjectsOfType.size() <= s_NearestScanLimit)
 	{
-		for (auto gameObject : m_GameObjects)
+		for (GameObject* gameObject : gameObjectsOfType)
 		{
-			if (gameObject.second->t().distance(position) <= maxDistance)
-			{
-				out_GameObjects.push_back(gameObject.second);
-				count++;
-			}
+			f3 d(gameObject->t() - position);
+			s_NearestHeap.Offer(d * d, gameObject);
 		}
 	}
 	else
 	{
-		for (auto gameObject : m_GameObjectsByType.at(typeFilter))
-		{
-			if (gameObject->t().distance(position) <= maxDistance)
-			{
-				out_GameObjects.push_back(gameObject);
-				count++;
-			}
-		}
+		CollisionFilter filter((typeFilter == OBJ_ANY) ? CollisionFilter::All() : CollisionFilter(typeFilter));
+		CollisionManager::GetInstance().QueryNearest(position, filter, s_NearestHeap);
 	}
 
+	return s_NearestHeap.Write(out_GameObjects);
+}
+
+// Retrieves the k-nearest game object to the specified position considering x and y coordinates (returns the number of game objects found)
+size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f2& position, size_t k, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+{
+	// Do not grow the list beyond the number of game objects in the world
+	size_t gameObjectCount = CollisionManager::GetInstance().GetProxyCount();
+	if (k > gameObjectCount) { k = gameObjectCount; }
+
+	size_t offset = out_GameObjects.size();
+	out_GameObjects.resize(offset + k);
+	size_t count = RetrieveKNearestGameObjects(position, k, out_GameObjects.data() + offset, typeFilter);
+	out_GameObjects.resize(offset + count);
+	return count;
+}
+
+// Retrieves the k-nearest game object to the specified position considering x, y and z coordinates (returns the number of game objects found)
+size_t Engine::WorldManager::RetrieveKNearestGameObjects(const f3& position, size_t k, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+{
+	// Do not grow the list beyond the number of game objects in the world
+	size_t gameObjectCount = CollisionManager::GetInstance().GetProxyCount();
+	if (k > gameObjectCount) { k = gameObjectCount; }
+
+	size_t offset = out_GameObjects.size();
+	out_GameObjects.resize(offset + k);
+	size_t count = RetrieveKNearestGameObjects(position, k, out_GameObjects.data() + offset, typeFilter);
+	out_GameObjects.resize(offset + count);
 	return count;
 }
 
+// Retrieves game objects closer than the specified distance to a point considering x and y coordinates, up to the capacity of the buffer (returns the number of game objects written to the buffer)
+size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f2& position, float maxDistance, GameObject** out_GameObjects, size_t capacity, GameObjectType typeFilter) const
+{
+	size_t count = 0;
+	ForEachGameObjectNearPosition(position, maxDistance, typeFilter, [out_GameObjects, capacity, &count](GameObject* gameObject) { if (count < capacity) { out_GameObjects[count++] = gameObject; } });
+	return count;
+}
+
+// Retrieves game objects closer than the specified distance to a point considering x, y and z coordinates, up to the capacity of the buffer (returns the number of game objects written to the buffer)
+size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f3& position, float maxDistance, GameObject** out_GameObjects, size_t capacity, GameObjectType typeFilter) const
+{
+	size_t count = 0;
+	ForEachGameObjectNearPosition(position, maxDistance, typeFilter, [out_GameObjects, capacity, &count](GameObject* gameObject) { if (count < capacity) { out_GameObjects[count++] = gameObject; } });
+	return count;
+}
+
+// Retrieves all game objects closer than the specified distance to a point considering x and y coordinates (returns the number of game objects found)
+size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f2& position, float maxDistance, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+{
+	size_t count = out_GameObjects.size();
+	ForEachGameObjectNearPosition(position, maxDistance, typeFilter, [&out_GameObjects](GameObject* gameObject) { out_GameObjects.push_back(gameObject); });
+	return out_GameObjects.size() - count;
+}
+
+// Retrieves all game objects closer than the specified distance to a point considering x, y and z coordinates(returns the number of game objects found)
+size_t Engine::WorldManager::RetrieveGameObjectsNearPosition(const f3& position, float maxDistance, std::vector<GameObject*>& out_GameObjects, GameObjectType typeFilter)
+{
+	size_t count = out_GameObjects.size();
+	ForEachGameObjectNearPosition(position, maxDistance, typeFilter, [&out_GameObjects](GameObject* gameObject) { out_GameObjects.push_back(gameObject); });
+	return out_GameObjects.size() - count;
+}
+
 // Removes all game objects that have been marked for removal
 void Engine::WorldManager::RemoveMarkedGameObjects()
 {
-	for (GameObjectGUID gameObjectGUID : m_GameObjectRemoveList)
+	// Swap the list out, so game objects removed from Destroy() are removed in the next batch
+	while (!m_GameObjectRemoveList.empty())
 	{
-		// Check if the game object still exists
-		if (m_GameObjects.count(gameObjectGUID) == 0) { continue; }
-
-		// Delete the game object and remove it from the game world
-		RemoveFromByTypeMap(m_GameObjects[gameObjectGUID]);
-		m_GameObjects[gameObjectGUID]->Destroy();
-		delete m_GameObjects[gameObjectGUID];
-		m_GameObjects.erase(gameObjectGUID);
+		m_GameObjectRemoveBatch.swap(m_GameObjectRemoveList);
+		for (GameObjectHandle handle : m_GameObjectRemoveBatch)
+		{
+			// Check if the game object still exists (stale handles do not resolve)
+			GameObject* gameObject = Retrieve(handle);
+			if (gameObject == NULL) { continue; }
+
+			// Delete the game object and remove it from the game world (deleting it invalidates its handle)
+			RemoveFromTypeIndex(gameObject);
+			RemoveFromBroadphase(gameObject);
+			if (!gameObject->m_Sleeping) { RemoveFromUpdateTier(gameObject); }
+			if (gameObject->m_Moving) { RemoveMover(gameObject); }
+			gameObject->SetFlag(FLAG_IN_WORLD, false);
+			gameObject->Destroy();
+			DeleteGameObject(gameObject);
+		}
+		m_GameObjectRemoveBatch.clear();
 	}
+}
 
-	m_GameObjectRemoveList.clear();
+// Deletes a game object, or returns it to its pool
+void Engine::WorldManager::DeleteGameObject(GameObject* gameObject)
+{
+	if (gameObject->m_Pool != NULL) { gameObject->m_Pool->Release(gameObject); }
+	else { delete gameObject; }
 }
 
+// Initial capacity of the spawn and removal queues
+const size_t Engine::WorldManager::s_InitialQueueCapacity = 1024;
+
+// Number of game objects of a type up to which nearest neighbour queries scan the by-type index instead of the position tree
+const size_t Engine::WorldManager::s_NearestScanLimit = 64;
+
+// Heap of the nearest neighbour queries of the current thread
+thread_local Engine::NearestGameObjectHeap Engine::WorldManager::s_NearestHeap;
+
+// Collision candidates of the moving game object of the current thread
+thread_local Engine::SweptAABBBatch Engine::WorldManager::s_SweptCandidates;
+
+// Collider of the merged rectangles of the static geometry
+const Engine::Collider Engine::WorldManager::s_StaticCollider = { Engine::Collider::Shape::AABB, 0.0f };
+
+// Command buffer of the current thread (NULL outside of parallel updates)
+thread_local Engine::WorldCommandBuffer* Engine::WorldManager::s_CommandBuffer = NULL;
+
 // Maximum number of iterations in movement solver
 const unsigned char Engine::WorldManager::s_MaxMovementIterations = 8;
 
@@ -461,32 +833,78 @@ void Engine::WorldManager::DrawBoundingBoxes() const
 	Engine::GraphicsManager& g = Engine::GraphicsManager::GetInstance();
 	Engine::colorRGBA c(0.8f, 0.2f, 0.2f, 1.0f);
 
-	for (auto gameObject : m_GameObjects)
-	{
-		g.DrawRectangle(gameObject.second->aabb2D_world(), c);
-	}
+	// Draw on top of the game objects (drawing is sorted by render layer and z)
+	unsigned char layer = g.GetRenderLayer();
+	g.SetRenderLayer(GraphicsManager::s_TopRenderLayer);
+	ForEachGameObject([&](GameObject* gameObject) { g.DrawRectangle(gameObject->aabb2D_world(), c); });
+	g.SetRenderLayer(layer);
 }
 
-// Adds a GameObject to the by-type indexed map
-void Engine::WorldManager::AddToByTypeMap(GameObject* gameObject)
+// Gets the game objects of a type in the by-type index (grows the index if needed)
+std::vector<Engine::GameObject*>& Engine::WorldManager::GetTypeIndex(GameObjectType type)
 {
-	if (m_GameObjectsByType.count(gameObject->type()) == 0)
-	{
-		std::list<GameObject*> gameObjectList;
-		gameObjectList.push_back(gameObject);
-		m_GameObjectsByType.insert(std::pair<GameObjectType, std::list<GameObject*>>(gameObject->type(), gameObjectList));
-	}
-	else
-	{
-		m_GameObjectsByType.at(gameObject->type()).push_back(gameObject);
-	}
+	if (type >= m_GameObjectsByType.size()) { m_GameObjectsByType.resize(type + 1); }
+	return m_GameObjectsByType[type];
 }
 
-// Removes a GameObject from the by-type indexed map
-void Engine::WorldManager::RemoveFromByTypeMap(GameObject* gameObject)
+// Adds a GameObject to the by-type index
+void Engine::WorldManager::AddToTypeIndex(GameObject* gameObject)
 {
-	if (m_GameObjectsByType.count(gameObject->type()) != 0)
+	std::vector<GameObject*>& gameObjectsOfType = GetTypeIndex(gameObject->type());
+	gameObject->m_TypeIndex = gameObjectsOfType.size();
+	gameObjectsOfType.push_back(gameObject);
+}
+
+// Removes a GameObject from the by-type index (moves the last game object of the type into its place)
+void Engine::WorldManager::RemoveFromTypeIndex(GameObject* gameObject)
+{
+	std::vector<GameObject*>& gameObjectsOfType = m_GameObjectsByType[gameObject->type()];
+	GameObject* last = gameObjectsOfType.back();
+	gameObjectsOfType[gameObject->m_TypeIndex] = last;
+	last->m_TypeIndex = gameObject->m_TypeIndex;
+	gameObjectsOfType.pop_back();
+}
+
+// Adds a game object to the broadphase of the collision manager (and numbers it for the draw order)
+void Engine::WorldManager::AddToBroadphase(GameObject* gameObject)
+{
+	gameObject->m_Sequence = m_AddedGameObjects++;
+	CollisionManager::GetInstance().AddProxy(gameObject);
+}
+
+// Removes a game object from the broadphase of the collision manager (and from the draw list)
+void Engine::WorldManager::RemoveFromBroadphase(GameObject* gameObject)
+{
+	CollisionManager::GetInstance().RemoveProxy(gameObject);
+
+	// Remove the game object from the draw list if it was visible
+	if (gameObject->m_DrawFrame == m_DrawFrame) { m_DrawList[gameObject->m_DrawIndex] = NULL; }
+}
+
+// Adds a game object to the update tier of its update interval (in the bucket holding the fewest game objects)
+void Engine::WorldManager::AddToUpdateTier(GameObject* gameObject)
+{
+	UpdateTier& tier = m_UpdateTiers[gameObject->m_UpdateInterval];
+	if (tier.m_Buckets.empty()) { tier.m_Buckets.resize(gameObject->m_UpdateInterval); }
+
+	// Stagger the updates of the tier by filling up its buckets evenly
+	unsigned int bucket = 0;
+	for (unsigned int i = 1; i < tier.m_Buckets.size(); i++)
 	{
-		m_GameObjectsByType[gameObject->type()].remove(gameObject);
+		if (tier.m_Buckets[i].size() < tier.m_Buckets[bucket].size()) { bucket = i; }
 	}
+
+	gameObject->m_UpdateBucket = bucket;
+	gameObject->m_UpdateIndex = tier.m_Buckets[bucket].size();
+	tier.m_Buckets[bucket].push_back(gameObject);
+}
+
+// Removes a game object from its update tier (moves the last game object of the bucket into its place)
+void Engine::WorldManager::RemoveFromUpdateTier(GameObject* gameObject)
+{
+	std::vector<GameObject*>& bucket = m_UpdateTiers[gameObject->m_UpdateInterval].m_Buckets[gameObject->m_UpdateBucket];
+	GameObject* last = bucket.back();
+	bucket[gameObject->m_UpdateIndex] = last;
+	last->m_UpdateIndex = gameObject->m_UpdateIndex;
+	bucket.pop_back();
 }
\ No newline at end of file
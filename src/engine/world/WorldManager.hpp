@@ -5,14 +5,28 @@
 #include "../common/patterns/Singleton.hpp" // Singleton pattern
 #include "GameObject.hpp" // For representing game objects
 #include "GameObjectCollection.hpp" // For representing a collection of game objects
+#include "GameObjectData.hpp" // For storing the transform, motion and AABB data of game objects
+#include "GameObjectHandle.hpp" // For identifying game objects
+#include "WorldCommandBuffer.hpp" // For recording world mutations during parallel updates
+#include "GameObjectPool.hpp" // For allocating game objects in per-type pools
+#include "GameObjectSpan.hpp" // For retrieving game objects without copying them
+#include "GameObjectQuery.hpp" // For querying game objects without copying them
 #include "../common/utility/GameTime.hpp" // For representing timing information on the game loop
 #include "../common/utility/VectorTypes.hpp" // For representing 2D and 3D positions
 #include "../common/utility/ShapeTypes.hpp" // For representing shapes
-#include "CollisionManager.hpp" // For collision checking
-
-#include <unordered_map> // For holding the game objects in the game world
-#include <list> // For holding the game objects that are marked for removal, and for indexing game objects
-#include <vector> // For returning lists of game objects
+#include "CollisionManager.hpp" // For collision checking, and for finding collision candidates and visible game objects in the broadphase
+#include "CollisionFilter.hpp" // For selecting the game objects that moving game objects collide with
+#include "NearestGameObjectHeap.hpp" // For finding the k nearest game objects without sorting all game objects
+#include "SweptAABBBatch.hpp" // For testing moving game objects against their collision candidates in packets
+#include "../timing/AlarmListener.hpp" // For waking up sleeping game objects on alarms
+
+#include <unordered_map> // For mapping game object types to their pools, and alarms to the game objects they wake up
+#include <map> // For holding the update tiers (sorted by update interval)
+#include <vector> // For returning lists of game objects, and for queueing game objects to be added and removed
+#include <functional> // For deferring writes to other game objects during parallel updates
+#include <memory> // For owning the game object pools
+#include <mutex> // For creating game object pools from multiple threads
+#include <typeindex> // For looking up the pool of a game object type
 
 namespace Engine{
 
@@ -25,7 +39,7 @@ namespace Engine{
 	// First valid GameObjectType index (to reserve lower indices for special meanings)
 	static const GameObjectType OBJ_OFFSET = GameObjectType(16);
 
-	class WorldManager : public Singleton<WorldManager>
+	class WorldManager : public Singleton<WorldManager>, public AlarmListener
 	{
 
 	public:
@@ -39,25 +53,105 @@ namespace Engine{
 		// Updates all game objects in the game world
 		void Update(const GameTime& gameTime);
 
-		// Draws all game objects in the game world
+		// Draws all game objects that are visible through the camera (in z order)
+		//		NOTE: game objects with a lower z are drawn first. Game objects
+		//		with the same z are drawn in the order they were added to the world.
 		void Draw(const GameTime& gameTime);
 
+		// Gets the dense storage holding the transform, motion and AABB data of all game objects
+		inline GameObjectDataStore& GetGameObjectData() { return m_GameObjectData; }
+
+		////////////////////////////////////////////////////////////////
+		// Parallel update                                            //
+		////////////////////////////////////////////////////////////////
+
+		// Enables or disables updating game objects on the threads of the job manager
+		//		NOTE: during a parallel update, adding and removing game objects and 
+		//		deferred functions are recorded per thread, and are applied after all 
+		//		game objects have been updated. Only game objects that opt in (see 
+		//		GameObject::IsThreadSafe()) are updated in parallel, all other game 
+		//		objects are updated serially afterwards.
+		void SetParallelUpdate(bool enabled);
+
+		// Checks whether game objects are updated on multiple threads
+		inline bool IsParallelUpdateEnabled() const { return m_ParallelUpdate; }
+
+		// Defers a function until the end of the parallel update (e.g. for writing to other game objects), or runs it immediately outside of parallel updates
+		void Defer(const std::function<void()>& function);
+
 		////////////////////////////////////////////////////////////////
 		// Game object creation and removal                           //
 		////////////////////////////////////////////////////////////////
 
-		// Adds a game object to the world and returns the handle
-		GameObjectGUID AddGameObject(GameObject* gameObject);
+		// Adds a game object to the world and returns the handle (returns an invalid handle if the world holds too many game objects)
+		//		NOTE: game objects added while the world is updating are queued, and 
+		//		are added in bulk after all game objects have been updated (they are 
+		//		updated for the first time in the next frame).
+		GameObjectHandle AddGameObject(GameObject* gameObject);
 
 		// Adds a group of game objects to the world 
 		void AddGameObjects(const GameObjectCollection& gameObjects);
 
+		// Reserves capacity for holding at least the specified number of game objects, and for spawning and removing them in bulk
+		void ReserveGameObjects(size_t capacity);
+
+		// Constructs a game object in the pool of its type and adds it to the world
+		//		NOTE: pooled game objects are returned to their pool when they are 
+		//		removed from the world, instead of being deleted.
+		template<typename T, typename... Args>
+		inline T* Spawn(Args&&... args)
+		{
+			T* gameObject = GetPool<T>().Construct(std::forward<Args>(args)...);
+			AddGameObject(gameObject);
+			return gameObject;
+		}
+
+		// Makes sure the pool of a game object type has at least the specified number of slots
+		template<typename T>
+		inline void ReservePool(size_t capacity) { GetPool<T>().Reserve(capacity); }
+
+		// Gets the allocation statistics of the pool of a game object type
+		template<typename T>
+		inline GameObjectPoolStats GetPoolStats() { return GetPool<T>().stats(); }
+
+		// Retrieves the allocation statistics of all game object pools
+		void RetrievePoolStats(std::vector<GameObjectPoolStats>& out_Stats) const;
+
 		// Removes a game object from the world
 		void RemoveGameObject(GameObject* gameObject);
 
+		// Removes a game object from the world (based on its handle)
+		void RemoveGameObject(GameObjectHandle handle);
+
 		// Removes a group of game objects from the world
 		void RemoveGameObjects(const GameObjectCollection& gameObjects);
 
+		////////////////////////////////////////////////////////////////
+		// Game object activity                                       //
+		////////////////////////////////////////////////////////////////
+
+		// Puts a game object to sleep (sleeping game objects are still drawn, but are not updated until woken up)
+		//		NOTE: activity changes made during the update are applied after 
+		//		the update. Game objects are woken up by WakeGameObject(), by an 
+		//		alarm (see WakeGameObjectOnAlarm), or when a moving game object 
+		//		collides with them.
+		void SleepGameObject(GameObjectHandle handle);
+
+		// Wakes up a sleeping game object
+		void WakeGameObject(GameObjectHandle handle);
+
+		// Wakes up a game object when an alarm of the timing manager goes off
+		void WakeGameObjectOnAlarm(GameObjectHandle handle, AlarmID alarmID);
+
+		// Sets the number of frames between updates of a game object (1 updates the game object every frame)
+		//		NOTE: game objects with the same update interval are spread evenly 
+		//		over the frames of the interval, and receive the delta time of all 
+		//		frames since their previous update.
+		void SetUpdateInterval(GameObjectHandle handle, unsigned int frames);
+
+		// Wakes up the game objects waiting for an alarm
+		virtual void ProcessAlarmEvent(AlarmID alarmID, Timestamp timestamp);
+
 		////////////////////////////////////////////////////////////////
 		// Game object retrieval									  //
 		////////////////////////////////////////////////////////////////
@@ -65,12 +159,51 @@ namespace Engine{
 		// Retrieves all game objects
 		size_t RetrieveAll(GameObjectCollection& out_GameObjectCollection) const;
 
-		// Retrieves the game object that matches the specified GUID
-		size_t RetrieveByGUID(GameObjectGUID guid, GameObjectCollection& out_GameObjectCollection) const;
+		// Retrieves the game object that matches the specified handle (returns NULL for stale handles)
+		inline GameObject* Retrieve(GameObjectHandle handle) const
+		{
+			GameObject* gameObject = m_GameObjectData.Resolve(handle);
+			return (gameObject != NULL && gameObject->HasFlag(FLAG_IN_WORLD)) ? gameObject : NULL;
+		}
+
+		// Retrieves the game object that matches the specified GUID or handle
+		size_t RetrieveByGUID(GameObjectHandle handle, GameObjectCollection& out_GameObjectCollection) const;
 
 		// Retrieves all game objects that matchs the specified type
 		size_t RetrieveByType(GameObjectType type, GameObjectCollection& out_GameObjectCollection) const;
 
+		// Retrieves all game objects that match the specified type, without copying them (returns an empty span for OBJ_ANY and OBJ_INVALID)
+		//		NOTE: the span is valid until game objects are added to or removed 
+		//		from the world, which happens after the update. Spans retrieved 
+		//		during the update are therefore valid for the rest of the frame's update.
+		GameObjectSpan RetrieveByType(GameObjectType type) const;
+
+		// Creates a query over all game objects that match the specified type (OBJ_ANY queries all game objects in the world)
+		//		NOTE: the query is evaluated lazily, and is subject to the same 
+		//		lifetime as the spans returned by RetrieveByType.
+		GameObjectQuery Query(GameObjectType type = GameObjectType(Engine::OBJ_ANY)) const;
+
+		// Retrieves the k-nearest game objects to the specified position considering x and y coordinates, nearest first (returns the number of game objects written to the buffer)
+		//		NOTE: the buffer must hold at least k game objects. Game objects 
+		//		are found in the position tree of the collision manager, or by 
+		//		scanning the by-type index for types with few game objects. No
+		//		memory is allocated once the heap of the calling thread has grown
+		//		to k game objects, so this can be called per game object per frame.
+		size_t RetrieveKNearestGameObjects(const f2& position, size_t k, GameObject** out_GameObjects, GameObjectType typeFilter = GameObjectType(Engine::OBJ_ANY)) const;
+
+		// Retrieves the k-nearest game objects to the specified position considering x, y and z coordinates, nearest first (returns the number of game objects written to the buffer)
+		size_t RetrieveKNearestGameObjects(const f3& position, size_t k, GameObject** out_GameObjects, GameObjectType typeFilter = GameObjectType(Engine::OBJ_ANY)) const;
+
+		// Retrieves game objects closer than the specified distance to a point considering x and y coordinates, up to the capacity of the buffer (returns the number of game objects written to the buffer)
+		//		NOTE: only the part of the position tree around the point is 
+		//		visited, and distances are compared squared, so the cost depends 
+		//		on the number of game objects near the point rather than on the 
+		//		number of game objects in the world.
+		size_t RetrieveGameObjectsNearPosition(const f2& position, float maxDistance, GameObject** out_GameObjects, size_t capacity, GameObjectType typeFilter = GameObjectType(Engine::OBJ_ANY)) const;
+
+		// Retrieves game objects closer than the specified distance to a point considering x, y and z coordinates, up to the capacity of the buffer (returns the number of game objects written to the buffer)
+		size_t RetrieveGameObjectsNearPosition(const f3& position, float maxDistance, GameObject** out_GameObjects, size_t capacity, GameObjectType typeFilter = GameObjectType(Engine::OBJ_ANY)) const;
+
 		///////////////////////////////////////////////////////// Legacy
 
 		// Retrieves the nearest game object to the specified position considering x and y coordinates (returns whether a game object was found)
@@ -129,39 +262,41 @@ namespace Engine{
 
 		// Finds the nearest collision along a specified motion vector
 		template<typename valuetype>
-		inline bool FindFirstCollision2D(GameObject& gameObject, const vector2D<valuetype>& motion, const GameObjectCollection& other, vector2D<valuetype>& out_Position, vector2D<valuetype>& out_Normal, valuetype& out_Progression)
+		inline bool FindFirstCollision2D(GameObject& gameObject, const vector2D<valuetype>& motion, const CollisionFilter& filter, vector2D<valuetype>& out_Position, vector2D<valuetype>& out_Normal, valuetype& out_Progression)
 		{
 			// Initialize to full motion (1.0 progression)
 			out_Position = gameObject.t2D() + motion;
 			out_Progression = 1.0f;
 
-			vector2D<valuetype> currentPosition;
-			vector2D<valuetype> currentNormal;
-			valuetype currentProgression = 1.0f;
-
-			bool collision = false;
-
-			// Ray cast all other objects to find the nearest collision
-			CollisionManager c = CollisionManager::GetInstance();
-
-			for (GameObject* g : other.objects()) {
-				if (gameObject.guid() == g->guid()) { continue; }
-				if (c.IsIntersecting(gameObject.aabb2D_world(), g->aabb2D_world(), motion, currentPosition, currentNormal, currentProgression))
-				{
-					if (currentProgression < out_Progression)
-					{
-						out_Progression = currentProgression;
-						out_Position = currentPosition;
-						out_Normal = currentNormal;
-						collision = true;
-						if (currentProgression == 0.0f) { return true; }
-					}
-				}
-			}
-
-			return collision;
+			// Collect all other objects and merged static rectangles overlapping the swept AABB
+			const aabb2D<valuetype>& aabb = gameObject.aabb2D_world();
+			SweptAABBBatch& candidates = s_SweptCandidates;
+			candidates.Clear();
+			bool shaped = gameObject.m_Collider.m_Shape != Collider::Shape::AABB;
+			CollisionManager& collision = CollisionManager::GetInstance();
+			collision.QuerySwept(aabb, motion, filter, [&](GameObject* g) {
+				if (g != &gameObject) { candidates.Add(g->aabb2D_world_uncached(), g); shaped |= g->m_Collider.m_Shape != Collider::Shape::AABB; }
+			});
+			collision.QueryStaticSwept(aabb, motion, filter, [&](const aabb2Df& rectangle, GameObject* g) {
+				if (g != &gameObject) { candidates.Add(rectangle, g); }
+			});
+
+			// Ray cast the candidates in packets to find the nearest collision, or test them by shape if any of the colliders is not an AABB
+			GameObject* collider = shaped ? FindFirstShape2D(gameObject, candidates, motion, out_Position, out_Normal, out_Progression) : candidates.FindFirst(aabb, motion, out_Position, out_Normal, out_Progression);
+
+			// Wake up the game object that was hit
+			if (collider != NULL && collider->IsSleeping()) { WakeGameObject(collider->handle()); }
+
+			return collider != NULL;
 		}
 
+		// Finds the first candidate hit by a moving game object, testing the colliders of both (returns NULL if no candidate is hit)
+		//		NOTE: like the packet test, the candidate with the lowest 
+		//		progression is hit, the candidate added first is hit on ties, and
+		//		hits at the end of the motion are not reported. Static rectangles 
+		//		are tested as AABBs.
+		GameObject* FindFirstShape2D(GameObject& gameObject, const SweptAABBBatch& candidates, const f2& motion, f2& out_Position, f2& out_Normal, float& out_Progression);
+
 		// Move a game object along the specified motion vector, ignoring collisions
 		template<typename valuetype>
 		inline void MoveIgnore2D(GameObject& gameObject, const vector2D<valuetype>& motion)
@@ -171,21 +306,15 @@ namespace Engine{
 
 		// Move a game object along the specified motion vector, stopping at the first collision
 		template<typename valuetype>
-		inline bool MoveStop2D(GameObject& gameObject, const vector2D<valuetype>& motion, const GameObjectCollection& other, bool updateVelocity)
+		inline bool MoveStop2D(GameObject& gameObject, const vector2D<valuetype>& motion, const CollisionFilter& filter, bool updateVelocity)
 		{
-			// Broadphase filtering based on AABB sweep
-			CollisionManager& c(CollisionManager::GetInstance());
-			aabb2D<valuetype> sweep(gameObject.aabb2D_world().sweep(motion));
-			GameObjectCollection otherBP(other);
-			otherBP.FilterByOverlap(sweep);
-
 			// Output variables for collision finder
 			vector2D<valuetype> position;
 			vector2D<valuetype> normal;
 			valuetype progression;
 
 			// Move the object and push it out of colliding objects
-			bool collision = FindFirstCollision2D(gameObject, motion, otherBP, position, normal, progression);
+			bool collision = FindFirstCollision2D(gameObject, motion, filter, position, normal, progression);
 			if (progression == 0.0f) { gameObject.velocity(f3(0.0)); return true; }
 			gameObject.t() += motion * progression;
 			if (collision) { PushOut2D(gameObject, motion); if (updateVelocity) { gameObject.velocity(f3(0.0)); } }
@@ -195,14 +324,8 @@ namespace Engine{
 
 		// Move a game object along the specified motion vector, sliding along colliding objects
 		template<typename valuetype>
-		inline bool MoveSlide2D(GameObject& gameObject, const vector2D<valuetype>& motion, const GameObjectCollection& other)
+		inline bool MoveSlide2D(GameObject& gameObject, const vector2D<valuetype>& motion, const CollisionFilter& filter)
 		{
-			// Broadphase filtering based on AABB sweep
-			CollisionManager& c(CollisionManager::GetInstance());
-			aabb2D<valuetype> sweep(gameObject.aabb2D_world().sweep(motion));
-			GameObjectCollection otherBP(other);
-			otherBP.FilterByOverlap(sweep);
-
 			// Output variables for collision finder
 			vector2D<valuetype> position;
 			vector2D<valuetype> normal;
@@ -217,7 +340,7 @@ namespace Engine{
 			do
 			{
 				// Move the object and push it out of colliding objects
-				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, otherBP, position, normal, progression);
+				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, filter, position, normal, progression);
 				if (progression == 0.0f) { return true; }
 				gameObject.t() += motion_i * progression;
 				collision |= collisionCurrent;
@@ -236,7 +359,7 @@ namespace Engine{
 
 		// Move a game object along the specified motion vector, redirecting motion along colliding objects
 		template<typename valuetype>
-		inline bool MoveRedirect2D(GameObject& gameObject, const vector2D<valuetype>& motion, const GameObjectCollection& other, bool updateVelocity)
+		inline bool MoveRedirect2D(GameObject& gameObject, const vector2D<valuetype>& motion, const CollisionFilter& filter, bool updateVelocity)
 		{
 			// Output variables for collision finder
 			vector2D<valuetype> position;
@@ -251,14 +374,8 @@ namespace Engine{
 
 			do
 			{
-				// Broadphase filtering based on AABB sweep
-				CollisionManager& c(CollisionManager::GetInstance());
-				aabb2D<valuetype> sweep(gameObject.aabb2D_world().sweep(motion_i));
-				GameObjectCollection otherBP(other);
-				otherBP.FilterByOverlap(sweep);
-
 				// Move the object and push it out of colliding objects
-				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, otherBP, position, normal, progression);
+				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, filter, position, normal, progression);
 				if (progression == 0.0f) { return true; }
 				gameObject.t() += motion_i * progression;
 				collision |= collisionCurrent;
@@ -279,7 +396,7 @@ namespace Engine{
 
 		// Move a game object along the specified motion vector, reflecting of colliding objects
 		template<typename valuetype>
-		inline bool MoveReflect2D(GameObject& gameObject, const vector2D<valuetype>& motion, const GameObjectCollection& other, bool updateVelocity)
+		inline bool MoveReflect2D(GameObject& gameObject, const vector2D<valuetype>& motion, const CollisionFilter& filter, bool updateVelocity)
 		{
 			// Output variables for collision finder
 			vector2D<valuetype> position;
@@ -294,14 +411,8 @@ namespace Engine{
 
 			do
 			{
-				// Broadphase filtering based on AABB sweep
-				CollisionManager& c(CollisionManager::GetInstance());
-				aabb2D<valuetype> sweep(gameObject.aabb2D_world().sweep(motion_i));
-				GameObjectCollection otherBP(other);
-				otherBP.FilterByOverlap(sweep);
-
 				// Move the object and push it out of colliding objects
-				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, otherBP, position, normal, progression);
+				bool collisionCurrent = FindFirstCollision2D(gameObject, motion_i, filter, position, normal, progression);
 				if (progression == 0.0f) { return true; }
 				gameObject.t() += motion_i * progression;
 				collision |= collisionCurrent;
@@ -318,44 +429,90 @@ namespace Engine{
 			return collision;
 		}
 
-	public:
-
-		// Moves a game object along the specified motion vector, resolving collisions on the way
+		// Moves a game object along the specified motion vector with the specified collision response (does not move its proxies)
 		template<typename valuetype>
-		inline bool Move2D(GameObject& gameObject, const vector2D<valuetype>& motion, CollisionResponse response, const GameObjectCollection& other, bool updateVelocity = false)
+		inline bool Solve2D(GameObject& gameObject, const vector2D<valuetype>& motion, CollisionResponse response, const CollisionFilter& filter, bool updateVelocity)
 		{
-			// If collisions should be ignored, skip broadphase filtering
-			if (response == CollisionResponse::IGNORE) { MoveIgnore2D(gameObject, motion); return false; }
-
-			// Move the object based on the specified collision response
 			switch (response)
 			{
+			case CollisionResponse::IGNORE:
+				MoveIgnore2D(gameObject, motion);
+				return false;
 			case CollisionResponse::STOP:
-				return MoveStop2D(gameObject, motion, other, updateVelocity);
+				return MoveStop2D(gameObject, motion, filter, updateVelocity);
 			case CollisionResponse::SLIDE:
-				return MoveSlide2D(gameObject, motion, other);
+				return MoveSlide2D(gameObject, motion, filter);
 			case CollisionResponse::REDIRECT:
-				return MoveRedirect2D(gameObject, motion, other, updateVelocity);
+				return MoveRedirect2D(gameObject, motion, filter, updateVelocity);
 			case CollisionResponse::REFLECT:
-				return MoveReflect2D(gameObject, motion, other, updateVelocity);
+				return MoveReflect2D(gameObject, motion, filter, updateVelocity);
 			}
+			return false;
 		}
 
-		// Moves the game object based on its velocity, resolving collisions on the way
+	public:
+
+		// Moves a game object along the specified motion vector, resolving collisions with the game objects that match the filter
+		//		NOTE: the game objects to collide with are found in the broadphase 
+		//		of the collision manager, by the swept AABB of the moving game 
+		//		object. Outside of parallel updates, the proxy of the moved game 
+		//		object is updated right away, so game objects that move after it 
+		//		collide with its new position. During parallel updates, proxies 
+		//		are updated at the sync point after the parallel phase.
 		template<typename valuetype>
-		inline bool Move2D(GameObject& gameObject, valuetype deltaTimeSeconds, CollisionResponse response, const GameObjectCollection& other, bool updateVelocity = true)
+		inline bool Move2D(GameObject& gameObject, const vector2D<valuetype>& motion, CollisionResponse response, const CollisionFilter& filter, bool updateVelocity = false)
+		{
+			bool collision = Solve2D(gameObject, motion, response, filter, updateVelocity);
+
+			// Move the proxy of the game object (the broadphase is only changed outside of parallel updates)
+			if (s_CommandBuffer == NULL) { CollisionManager::GetInstance().UpdateProxy(&gameObject); }
+
+			return collision;
+		}
+
+		// Moves the game object based on its velocity, resolving collisions with the game objects that match the filter
+		template<typename valuetype>
+		inline bool Move2D(GameObject& gameObject, valuetype deltaTimeSeconds, CollisionResponse response, const CollisionFilter& filter, bool updateVelocity = true)
 		{
 			// Calculate the motion vector from the velocity and delta time
 			vector2D<valuetype> motion = gameObject.velocity2D() * deltaTimeSeconds;
 
-			return Move2D(gameObject, motion, response, other, updateVelocity);
+			return Move2D(gameObject, motion, response, filter, updateVelocity);
 		}
 
+		// Moves a game object along the specified motion vector, resolving collisions with the game objects in its collision mask
+		template<typename valuetype>
+		inline bool Move2D(GameObject& gameObject, const vector2D<valuetype>& motion, CollisionResponse response)
+		{
+			return Move2D(gameObject, motion, response, CollisionFilter::Categories(gameObject.collisionMask()), false);
+		}
+
+		// Moves the game object based on its velocity, resolving collisions with the game objects in its collision mask
+		template<typename valuetype>
+		inline bool Move2D(GameObject& gameObject, valuetype deltaTimeSeconds, CollisionResponse response)
+		{
+			return Move2D(gameObject, deltaTimeSeconds, response, CollisionFilter::Categories(gameObject.collisionMask()), true);
+		}
+
+		////////////////////////////////////////////////////////////////
+		// Batched movement                                           //
+		////////////////////////////////////////////////////////////////
+
+		// Registers a game object to be moved by its velocity every frame, resolving collisions with the game objects that match the filter
+		//		NOTE: registered game objects are moved together once all game 
+		//		objects have been updated, instead of calling Move2D from their 
+		//		update. Registering a game object again changes its collision 
+		//		response and filter. Sleeping game objects are not moved.
+		void RegisterMover(GameObjectHandle handle, CollisionResponse response, const CollisionFilter& filter, bool updateVelocity = true);
+
+		// Stops moving a game object every frame
+		void UnregisterMover(GameObjectHandle handle);
+
 		////////////////////////////////////////////////////////////////
 		// Debug rendering                                            //
 		////////////////////////////////////////////////////////////////
 
-		// Draws the bounding boxes of all game objects
+		// Draws the bounding boxes of all game objects (in the topmost render layer)
 		void DrawBoundingBoxes() const;
 
 	private:
@@ -363,24 +520,268 @@ namespace Engine{
 		// Incrementing counter for handles
 		unsigned int m_Handles;
 
-		// Data structure holding all GameObjects (mapped by GUID)
-		std::unordered_map<GameObjectGUID, GameObject*> m_GameObjects;
+		// Dense storage holding the transform, motion and AABB data of all game objects
+		GameObjectDataStore m_GameObjectData;
+
+		// Data structure holding all GameObjects (indexed by GameObjectType, dense per type)
+		std::vector<std::vector<GameObject*>> m_GameObjectsByType;
+
+		// Gets the game objects of a type in the by-type index (grows the index if needed)
+		std::vector<GameObject*>& GetTypeIndex(GameObjectType type);
+
+		// Adds a GameObject to the by-type index
+		void AddToTypeIndex(GameObject* gameObject);
+
+		// Removes a GameObject from the by-type index (moves the last game object of the type into its place)
+		void RemoveFromTypeIndex(GameObject* gameObject);
+
+		// Number of game objects of a type up to which nearest neighbour queries scan the by-type index instead of the position tree
+		static const size_t s_NearestScanLimit;
+
+		// Heap of the nearest neighbour queries of the current thread
+		static thread_local NearestGameObjectHeap s_NearestHeap;
+
+		// Collision candidates of the moving game object of the current thread
+		static thread_local SweptAABBBatch s_SweptCandidates;
+
+		// Collider of the merged rectangles of the static geometry
+		static const Collider s_StaticCollider;
 
-		// Data structure holding all GameObjects (mapped by GameObjectType)
-		std::unordered_map<GameObjectType, std::list<GameObject*>> m_GameObjectsByType;
+		// Gets the squared distance from a game object to a position considering x and y coordinates
+		static inline float DistanceSquared(const GameObject* gameObject, const f2& position) { f2 d(gameObject->t2D() - position); return d * d; }
 
-		// Adds a GameObject to the by-type indexed map
-		void AddToByTypeMap(GameObject* gameObject);
+		// Gets the squared distance from a game object to a position considering x, y and z coordinates
+		static inline float DistanceSquared(const GameObject* gameObject, const f3& position) { f3 d(gameObject->t() - position); return d * d; }
 
-		// Removes a GameObject from the by-type indexed map
-		void RemoveFromByTypeMap(GameObject* gameObject);
+		// Calls a function on all game objects closer than the specified distance to a position (scans the by-type index for types with few game objects)
+		template<typename vectortype, typename function>
+		inline void ForEachGameObjectNearPosition(const vectortype& position, float maxDistance, GameObjectType typeFilter, function f) const
+		{
+			GameObjectSpan gameObjectsOfType = RetrieveByType(typeFilter);
+			if (typeFilter != OBJ_ANY && gameObjectsOfType.size() <= s_NearestScanLimit)
+			{
+				float maxDistanceSquared = maxDistance * maxDistance;
+				for (GameObject* gameObject : gameObjectsOfType)
+				{
+					if (DistanceSquared(gameObject, position) <= maxDistanceSquared) { f(gameObject); }
+				}
+				return;
+			}
+
+			CollisionFilter filter((typeFilter == OBJ_ANY) ? CollisionFilter::All() : CollisionFilter(typeFilter));
+			CollisionManager::GetInstance().QueryRadius(position, maxDistance, filter, f);
+		}
+
+		// Adds a game object to the broadphase of the collision manager (and numbers it for the draw order)
+		void AddToBroadphase(GameObject* gameObject);
+
+		// Removes a game object from the broadphase of the collision manager (and from the draw list)
+		void RemoveFromBroadphase(GameObject* gameObject);
+
+		// Number of game objects that have been added to the world
+		unsigned long long m_AddedGameObjects;
+
+		// Number of the frame that is drawn (starts at 1, so game objects that were never drawn are not considered visible)
+		unsigned long long m_DrawFrame;
+
+		// Game objects that were visible in the last drawn frame (in draw order)
+		std::vector<GameObject*> m_DrawList;
+
+		// Game objects that became visible in the frame that is drawn (merged into the draw list once sorted)
+		std::vector<GameObject*> m_NewlyVisible;
+
+		// Checks whether a game object is drawn before another game object
+		static inline bool IsDrawnBefore(const GameObject* a, const GameObject* b)
+		{
+			if (a->t().z() != b->t().z()) { return a->t().z() < b->t().z(); }
+			return a->m_Sequence < b->m_Sequence;
+		}
+
+		// Game object that is moved every frame by the batched movement pass
+		struct Mover
+		{
+			GameObject* m_GameObject;
+			CollisionResponse m_Response;
+			CollisionFilter m_Filter;
+			bool m_UpdateVelocity;
+		};
+
+		// Game objects that are moved every frame (in registration order)
+		std::vector<Mover> m_Movers;
+
+		// Motion of every mover in the current frame
+		std::vector<f2> m_MoverMotion;
+
+		// Area every mover can reach in the current frame
+		std::vector<aabb2Df> m_MoverReach;
+
+		// Islands of movers that can reach each other (parent of every mover in the union-find, island of every mover, movers ordered by island, first mover of every island, and next free place of every island)
+		std::vector<size_t> m_MoverIslandParent;
+		std::vector<size_t> m_MoverIsland;
+		std::vector<size_t> m_MoverIslandOrder;
+		std::vector<size_t> m_MoverIslandOffsets;
+		std::vector<size_t> m_MoverIslandInsert;
+
+		// Removes a game object from the movers (moves the last mover into its place)
+		void RemoveMover(GameObject* gameObject);
+
+		// Checks whether a mover is moved this frame (movers that are asleep or not in the world are skipped)
+		inline bool IsMoving(const Mover& mover) const { return mover.m_GameObject->HasFlag(FLAG_IN_WORLD) && !mover.m_GameObject->m_Sleeping; }
+
+		// Moves all registered game objects by their velocity, resolving collisions in a single pass over the broadphase
+		//		NOTE: the broadphase is synchronized once, and the proxy of every 
+		//		mover is enlarged to the area it can reach this frame, so proxies
+		//		do not change while movers are resolved. Movers are resolved in 
+		//		registration order. In parallel updates, movers that cannot reach
+		//		each other are split into islands that are resolved on different
+		//		threads (in registration order within each island), which gives
+		//		exactly the same result as resolving them serially.
+		void MoveAll2D(const GameTime& gameTime);
+
+		// Splits the movers into islands of movers that can reach each other (returns the number of islands)
+		size_t BuildMoverIslands();
+
+		// Finds the island of a mover (with path halving)
+		inline size_t FindMoverIsland(size_t mover)
+		{
+			while (m_MoverIslandParent[mover] != mover)
+			{
+				m_MoverIslandParent[mover] = m_MoverIslandParent[m_MoverIslandParent[mover]];
+				mover = m_MoverIslandParent[mover];
+			}
+			return mover;
+		}
+
+		// Whether the game objects are currently being updated (game objects added in the meantime are queued)
+		bool m_Updating;
+
+		// Game objects that are updated once every number of frames (one bucket of game objects per frame of the interval)
+		struct UpdateTier
+		{
+			std::vector<std::vector<GameObject*>> m_Buckets;
+		};
+
+		// Update tiers of all game objects that are awake (mapped by update interval)
+		std::map<unsigned int, UpdateTier> m_UpdateTiers;
+
+		// Number of world updates so far (selects the bucket of each update tier that is updated)
+		unsigned long long m_UpdateFrame;
 
-		// List of game objects that are marked to be removed
-		std::list<GameObjectGUID> m_GameObjectRemoveList;
+		// Adds a game object to the update tier of its update interval (in the bucket holding the fewest game objects)
+		void AddToUpdateTier(GameObject* gameObject);
+
+		// Removes a game object from its update tier (moves the last game object of the bucket into its place)
+		void RemoveFromUpdateTier(GameObject* gameObject);
+
+		// Change in the activity of a game object
+		struct ActivityChange
+		{
+			// Types of activity changes
+			enum class Type
+			{
+				SLEEP,				// Put the game object to sleep
+				WAKE,				// Wake up the game object
+				UPDATE_INTERVAL		// Change the update interval of the game object
+			};
+
+			Type m_Type;
+			GameObjectHandle m_Handle;
+			unsigned int m_UpdateInterval;
+		};
+
+		// Activity changes that are queued to be applied after the update
+		std::vector<ActivityChange> m_ActivityQueue;
+
+		// Game objects that are woken up by alarms (mapped by alarm ID)
+		std::unordered_map<AlarmID, std::vector<GameObjectHandle>> m_AlarmWakeUps;
+
+		// Changes the activity of a game object, or queues the change while updating
+		void ChangeActivity(const ActivityChange& change);
+
+		// Applies the activity changes that are queued during the update
+		void ApplyQueuedActivityChanges();
+
+		// Initial capacity of the spawn and removal queues
+		static const size_t s_InitialQueueCapacity;
+
+		// Game objects that are queued to be added to the world
+		std::vector<GameObject*> m_SpawnQueue;
+
+		// Batch of queued game objects that is currently being added to the world
+		std::vector<GameObject*> m_SpawnBatch;
+
+		// Adds a batch of game objects to the world (creates them grouped by type)
+		void AddGameObjectBatch(std::vector<GameObject*>& gameObjects);
+
+		// Adds all game objects that are queued to be added to the world
+		void SpawnQueuedGameObjects();
+
+		// Whether queued game objects are currently being added (game objects added in the meantime are queued for the next batch)
+		bool m_Spawning;
+
+		// Pools of pooled game objects (mapped by the C++ type of the game objects)
+		std::unordered_map<std::type_index, std::unique_ptr<GameObjectPoolBase>> m_Pools;
+
+		// Mutex guarding the pool map
+		mutable std::mutex m_PoolsMutex;
+
+		// Gets the pool of a game object type (creates it on first use)
+		template<typename T>
+		inline GameObjectPool<T>& GetPool()
+		{
+			std::lock_guard<std::mutex> lock(m_PoolsMutex);
+			std::unique_ptr<GameObjectPoolBase>& pool = m_Pools[std::type_index(typeid(T))];
+			if (!pool) { pool.reset(new GameObjectPool<T>()); }
+			return static_cast<GameObjectPool<T>&>(*pool);
+		}
+
+		// Deletes a game object, or returns it to its pool
+		void DeleteGameObject(GameObject* gameObject);
+
+		// Handles of the game objects that are marked to be removed
+		std::vector<GameObjectHandle> m_GameObjectRemoveList;
+
+		// Batch of marked game objects that is currently being removed
+		std::vector<GameObjectHandle> m_GameObjectRemoveBatch;
 
 		// Removes all game objects that have been marked for removal
 		void RemoveMarkedGameObjects();
 
+		// Whether game objects are updated on multiple threads
+		bool m_ParallelUpdate;
+
+		// Command buffers of the threads of a parallel update (indexed by job manager thread index)
+		std::vector<WorldCommandBuffer> m_CommandBuffers;
+
+		// Game objects that are updated in parallel during the current update
+		std::vector<GameObject*> m_ParallelGameObjects;
+
+		// Game objects that are updated serially during the current update
+		std::vector<GameObject*> m_SerialGameObjects;
+
+		// Command buffer of the current thread (NULL outside of parallel updates)
+		static thread_local WorldCommandBuffer* s_CommandBuffer;
+
+		// Updates a group of game objects on the threads of the job manager
+		void UpdateParallel(const GameTime& gameTime, const std::vector<GameObject*>& gameObjects);
+
+		// Applies the world mutations recorded by all threads (in thread order)
+		void ApplyCommandBuffers();
+
+		// Calls a function for every game object in the game world (streams through the dense game object data)
+		template<typename function>
+		inline void ForEachGameObject(function f) const
+		{
+			for (size_t bi = 0; bi < m_GameObjectData.blockCount(); bi++)
+			{
+				const GameObjectDataBlock& b = m_GameObjectData.block(bi);
+				for (size_t i = 0; i < b.m_Size; i++)
+				{
+					if ((b.m_Flags[i] & FLAG_IN_WORLD) != 0) { f(b.m_Owner[i]); }
+				}
+			}
+		}
+
 	};
 }
 
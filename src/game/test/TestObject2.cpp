@@ -8,6 +8,9 @@ void GameContent::TestObject2::Create()
 {
 	m_SpriteSheetGoomba = Engine::ResourceManager::GetInstance().ReserveSpriteSheet("goomba.spritesheet");
 	m_Font = Engine::ResourceManager::GetInstance().ReserveBitmapFont("nesfont.bitmapfont");
+
+	// Move by velocity every frame, stopping at other test objects
+	Engine::WorldManager::GetInstance().RegisterMover(handle(), Engine::WorldManager::CollisionResponse::STOP, Engine::CollisionFilter(ID_TYPE::OBJ_TESTOBJECT));
 }
 
 // Destroys the game object
@@ -20,10 +23,6 @@ void GameContent::TestObject2::Destroy()
 void GameContent::TestObject2::Update(const Engine::GameTime& gameTime)
 {
 	TestObject2 bla(Engine::transform3D(), Engine::aabb3Df);
-
-	Engine::GameObjectCollection g;
-	Engine::WorldManager::GetInstance().RetrieveByType(ID_TYPE::OBJ_TESTOBJECT, g);
-	Engine::WorldManager::GetInstance().Move2D((*this), gameTime.GetDeltaTimeSeconds(), Engine::WorldManager::CollisionResponse::STOP, g); 
 }
 
 // Draws the game object
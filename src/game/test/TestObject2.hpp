@@ -43,6 +43,9 @@ namespace GameContent{
 		// Gets the type of the game object
 		virtual Engine::GameObjectType type() const { return ID_TYPE::OBJ_TESTOBJECT2; }
 
+		// Opts in to parallel updates (Update() only writes its own state, and moving against other test objects is resolved by the registered mover after the update)
+		virtual bool IsThreadSafe() const { return true; }
+
 	private:
 
 		// Spritesheet
@@ -0,0 +1,124 @@
+#include "..\engine\debugging\LoggingManager.hpp" // [DEBUGGING] Logging Manager
+#include "..\engine\jobs\JobManager.hpp" // [JOBS] Job Manager
+#include "..\engine\world\CollisionManager.hpp" // [WORLD] Collision Manager
+#include "..\engine\world\WorldManager.hpp" // [WORLD] World Manager
+
+#include <iostream> // For reporting the results
+#include <chrono> // For timing the frames
+#include <random> // For placing the movers
+
+// Ways of finding the collision candidates of the movers
+enum class Broadphase { LINEAR, TREE, GRID };
+
+static Broadphase s_Broadphase;
+static float s_WorldSize;
+static size_t s_Candidates;
+
+// Tile-sized game object that moves through the world, and finds the game objects its swept AABB overlaps with
+class Mover : public Engine::GameObject
+{
+
+public:
+
+	// Constructor
+	Mover(const Engine::transform3D& transform) : GameObject(transform, Engine::aabb3Df(0.0f, 16.0f, 0.0f, 16.0f, 0.0f, 0.0f)) { }
+
+	// Gets the type of the game object
+	Engine::GameObjectType type() const { return Engine::OBJ_OFFSET; }
+
+	// Finds the collision candidates along the motion of the mover, and moves it (bouncing off the edges of the world)
+	void Update(const Engine::GameTime& gameTime)
+	{
+		Engine::f2 motion = velocity2D() * (1.0f / 60.0f);
+		if (s_Broadphase == Broadphase::LINEAR)
+		{
+			Engine::GameObjectQuery candidates(Engine::WorldManager::GetInstance().RetrieveByType(type()));
+			s_Candidates += candidates.ByOverlap(aabb2D_world().sweep(motion)).Excluding(this).Count();
+		}
+		else
+		{
+			Engine::CollisionManager::GetInstance().QuerySwept(aabb2D_world(), motion, Engine::CollisionFilter(type()), [this](Engine::GameObject* g) { if (g != this) { s_Candidates++; } });
+		}
+
+		t() += motion;
+		if (t().x() < 0.0f || t().x() > s_WorldSize) { velocity().x(-velocity().x()); }
+		if (t().y() < 0.0f || t().y() > s_WorldSize) { velocity().y(-velocity().y()); }
+	}
+
+	// Movers should be updated serially, so all broadphases are measured on a single thread
+	bool IsThreadSafe() const { return false; }
+
+};
+
+// Runs a number of frames with the specified number of movers (returns the average duration of a frame in milliseconds)
+double RunBenchmark(Broadphase broadphase, size_t movers, unsigned int frames)
+{
+	Engine::WorldManager& world = Engine::WorldManager::GetInstance();
+	if (broadphase == Broadphase::GRID) { Engine::CollisionManager::GetInstance().SetBroadphase(Engine::CollisionManager::BroadphaseType::GRID, 16.0f); }
+	else { Engine::CollisionManager::GetInstance().SetBroadphase(Engine::CollisionManager::BroadphaseType::TREE); }
+
+	// Spread the movers over a world with room for four tiles per mover
+	s_Broadphase = broadphase;
+	s_WorldSize = 32.0f * sqrt(float(movers));
+	s_Candidates = 0;
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(0.0f, s_WorldSize);
+	std::uniform_real_distribution<float> speed(-60.0f, 60.0f);
+	std::vector<Engine::GameObjectHandle> handles;
+	for (size_t i = 0; i < movers; i++)
+	{
+		Mover* mover = new Mover(Engine::transform3D(position(random), position(random), 0.0f));
+		mover->velocity(Engine::f2(speed(random), speed(random)));
+		handles.push_back(world.AddGameObject(mover));
+	}
+
+	Engine::GameTime gameTime;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned int frame = 0; frame < frames; frame++) { world.Update(gameTime); }
+	auto end = std::chrono::high_resolution_clock::now();
+
+	for (Engine::GameObjectHandle handle : handles) { world.RemoveGameObject(handle); }
+	world.Update(gameTime);
+	return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+int main(int argc, char* argv[])
+{
+	Engine::LoggingManager::Create();
+	Engine::LoggingManager::GetInstance().Initialize();
+	Engine::JobManager::Create();
+	Engine::JobManager::GetInstance().Initialize();
+	Engine::CollisionManager::Create();
+	Engine::CollisionManager::GetInstance().Initialize();
+	Engine::WorldManager::Create();
+	Engine::WorldManager::GetInstance().Initialize();
+
+	const size_t movers[] = { 1000, 5000, 10000, 25000, 50000 };
+	std::cout << "movers\tlinear (ms)\ttree (ms)\tgrid (ms)" << std::endl;
+	for (size_t n : movers)
+	{
+		// All broadphases should find the same collision candidates (the linear scan is quadratic, so it runs a single frame)
+		double linear = RunBenchmark(Broadphase::LINEAR, n, 1);
+		size_t linearCandidates = s_Candidates;
+		RunBenchmark(Broadphase::TREE, n, 1);
+		size_t treeCandidates = s_Candidates;
+		RunBenchmark(Broadphase::GRID, n, 1);
+		size_t gridCandidates = s_Candidates;
+		if (treeCandidates != linearCandidates || gridCandidates != linearCandidates) { std::cout << "FAILED: broadphases disagree for " << n << " movers" << std::endl; }
+
+		double tree = RunBenchmark(Broadphase::TREE, n, 60);
+		double grid = RunBenchmark(Broadphase::GRID, n, 60);
+		std::cout << n << "\t" << linear << "\t" << tree << "\t" << grid << std::endl;
+	}
+
+	Engine::WorldManager::GetInstance().Terminate();
+	Engine::WorldManager::Destroy();
+	Engine::CollisionManager::GetInstance().Terminate();
+	Engine::CollisionManager::Destroy();
+	Engine::JobManager::GetInstance().Terminate();
+	Engine::JobManager::Destroy();
+	Engine::LoggingManager::GetInstance().Terminate();
+	Engine::LoggingManager::Destroy();
+
+	return 0;
+}
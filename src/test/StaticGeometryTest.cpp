@@ -0,0 +1,113 @@
+#include "..\engine\world\StaticGeometry.hpp" // [WORLD] Static geometry
+
+#include <iostream> // For reporting the results
+#include <chrono> // For timing the bake of unaligned solids
+#include <random> // For placing unaligned solids
+
+// Placeholder game objects of the solids (the static geometry never dereferences its game objects)
+static char s_GameObjects[4];
+
+// Adds a solid AABB to a list of solids (of a single type and collision category)
+void AddSolid(std::vector<Engine::StaticGeometry::Solid>& solids, float x1, float x2, float y1, float y2)
+{
+	Engine::StaticGeometry::Solid solid = { Engine::aabb2Df(x1, x2, y1, y2), reinterpret_cast<Engine::GameObject*>(&s_GameObjects[solids.size() % 4]), 0, 1 };
+	solids.push_back(solid);
+}
+
+// Retrieves all merged rectangles of the static geometry
+void RetrieveRectangles(const Engine::StaticGeometry& geometry, std::vector<Engine::aabb2Df>& out_Rectangles)
+{
+	out_Rectangles.clear();
+	geometry.QuerySwept(Engine::aabb2Df(-1.0e6f, 1.0e6f, -1.0e6f, 1.0e6f), Engine::f2(0.0f, 0.0f), Engine::CollisionFilter::All(), [&out_Rectangles](const Engine::aabb2Df& aabb, Engine::GameObject* gameObject) { out_Rectangles.push_back(aabb); });
+}
+
+// Checks whether the rectangles do not overlap each other, and cover exactly the specified area
+bool IsTiling(const std::vector<Engine::aabb2Df>& rectangles, float area)
+{
+	float total = 0.0f;
+	for (size_t i = 0; i < rectangles.size(); i++)
+	{
+		total += (rectangles[i].x2() - rectangles[i].x1()) * (rectangles[i].y2() - rectangles[i].y1());
+		for (size_t j = i + 1; j < rectangles.size(); j++)
+		{
+			if (rectangles[i].x1() < rectangles[j].x2() && rectangles[j].x1() < rectangles[i].x2() && rectangles[i].y1() < rectangles[j].y2() && rectangles[j].y1() < rectangles[i].y2()) { return false; }
+		}
+	}
+	return total == area;
+}
+
+int main(int argc, char* argv[])
+{
+	Engine::StaticGeometry geometry;
+	std::vector<Engine::StaticGeometry::Solid> solids;
+	std::vector<Engine::aabb2Df> rectangles;
+
+test1:
+	// Floor of 64 tiles is merged into a single rectangle
+	solids.clear();
+	for (int i = 0; i < 64; i++) { AddSolid(solids, float(i) * 16.0f, float(i + 1) * 16.0f, 0.0f, 16.0f); }
+	geometry.Bake(solids);
+	RetrieveRectangles(geometry, rectangles);
+	if (rectangles.size() == 1 && rectangles[0].x1() == 0.0f && rectangles[0].x2() == 1024.0f && rectangles[0].y1() == 0.0f && rectangles[0].y2() == 16.0f) { std::cout << "PASSED: Tile floor" << std::endl; goto test2; }
+	else { std::cout << "FAILED: Tile floor (" << rectangles.size() << " rectangles)" << std::endl; goto test2; }
+
+test2:
+	// L-shape of a wall and a floor of tiles is merged into two rectangles
+	solids.clear();
+	for (int i = 0; i < 8; i++) { AddSolid(solids, 0.0f, 16.0f, float(i) * 16.0f, float(i + 1) * 16.0f); }
+	for (int i = 1; i < 8; i++) { AddSolid(solids, float(i) * 16.0f, float(i + 1) * 16.0f, 0.0f, 16.0f); }
+	geometry.Bake(solids);
+	RetrieveRectangles(geometry, rectangles);
+	if (rectangles.size() == 2 && IsTiling(rectangles, 15.0f * 256.0f)) { std::cout << "PASSED: L-shape" << std::endl; goto test3; }
+	else { std::cout << "FAILED: L-shape (" << rectangles.size() << " rectangles)" << std::endl; goto test3; }
+
+test3:
+	// Overlapping solids are merged without covering any area twice
+	solids.clear();
+	AddSolid(solids, 0.0f, 32.0f, 0.0f, 32.0f);
+	AddSolid(solids, 16.0f, 48.0f, 16.0f, 48.0f);
+	AddSolid(solids, 8.0f, 24.0f, 8.0f, 24.0f);
+	geometry.Bake(solids);
+	RetrieveRectangles(geometry, rectangles);
+	if (!rectangles.empty() && rectangles.size() <= 3 && IsTiling(rectangles, 2.0f * 1024.0f - 256.0f)) { std::cout << "PASSED: Overlapping solids" << std::endl; goto test4; }
+	else { std::cout << "FAILED: Overlapping solids (" << rectangles.size() << " rectangles)" << std::endl; goto test4; }
+
+test4:
+	{
+		// Overlapping solids that are not aligned to a grid are kept unmerged (instead of building a grid that grows quadratically)
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+		solids.clear();
+		for (int i = 0; i < 20000; i++)
+		{
+			float x = float(i) * 10.3f + jitter(random);
+			float y = 5.0f * jitter(random);
+			AddSolid(solids, x, x + 13.7f, y, y + 9.3f);
+		}
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		geometry.Bake(solids);
+		double duration = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		if (geometry.size() == solids.size()) { std::cout << "PASSED: Unaligned solids (baked in " << duration << " ms)" << std::endl; goto test5; }
+		else { std::cout << "FAILED: Unaligned solids (" << geometry.size() << " rectangles)" << std::endl; goto test5; }
+	}
+
+test5:
+	{
+		// Platforms of tiles spread over a long level are each merged into a single rectangle (the grid of the whole level would be kept unmerged)
+		solids.clear();
+		for (int p = 0; p < 40; p++)
+		{
+			float x = float(p) * 2500.0f;
+			float y = float((p * 7) % 40) * 48.0f;
+			for (int i = 0; i < 4; i++) { AddSolid(solids, x + float(i) * 16.0f, x + float(i + 1) * 16.0f, y, y + 16.0f); }
+		}
+		geometry.Bake(solids);
+		RetrieveRectangles(geometry, rectangles);
+		if (rectangles.size() == 40 && IsTiling(rectangles, 40.0f * 4.0f * 256.0f)) { std::cout << "PASSED: Sparse level" << std::endl; goto end; }
+		else { std::cout << "FAILED: Sparse level (" << rectangles.size() << " rectangles)" << std::endl; goto end; }
+	}
+
+end:
+	std::cin.get();
+	return 0;
+}
@@ -0,0 +1,173 @@
+#include "..\engine\world\SweptAABBBatch.hpp" // [WORLD] Batched swept AABB tests
+
+#include <iostream> // For reporting the results
+#include <cstring> // For comparing the results bit by bit
+#include <random> // For generating the candidates
+#include <limits> // For moving by denormal amounts
+
+// Placeholder game objects of the candidates (the batch never dereferences its game objects)
+static char s_Candidates[64];
+
+// Result of finding the first candidate with one kernel
+struct Result
+{
+	Engine::GameObject* m_GameObject;
+	Engine::f2 m_Position;
+	Engine::f2 m_Normal;
+	float m_Progression;
+};
+
+// Finds the first candidate with the specified kernel
+Result FindFirst(Engine::SweptAABBBatch::Kernel kernel, const Engine::SweptAABBBatch& batch, const Engine::aabb2Df& aabb, const Engine::f2& motion)
+{
+	Engine::SweptAABBBatch::SetKernel(kernel);
+	Result result;
+	result.m_Position = Engine::f2(-1.0f, -1.0f);
+	result.m_Normal = Engine::f2(-1.0f, -1.0f);
+	result.m_Progression = -1.0f;
+	result.m_GameObject = batch.FindFirst(aabb, motion, result.m_Position, result.m_Normal, result.m_Progression);
+	return result;
+}
+
+// Checks whether two results are identical (the position, normal and progression bit by bit)
+bool IsIdentical(const Result& a, const Result& b)
+{
+	if (a.m_GameObject != b.m_GameObject) { return false; }
+	if (a.m_GameObject == NULL) { return true; }
+	float fa[5] = { a.m_Position.x(), a.m_Position.y(), a.m_Normal.x(), a.m_Normal.y(), a.m_Progression };
+	float fb[5] = { b.m_Position.x(), b.m_Position.y(), b.m_Normal.x(), b.m_Normal.y(), b.m_Progression };
+	return std::memcmp(fa, fb, sizeof(fa)) == 0;
+}
+
+// Tests a moving AABB against a batch with every supported kernel (returns whether all kernels find the same collision as the scalar kernel)
+bool TestKernels(const Engine::SweptAABBBatch& batch, const Engine::aabb2Df& aabb, const Engine::f2& motion, size_t& out_Hits)
+{
+	Result scalar = FindFirst(Engine::SweptAABBBatch::Kernel::SCALAR, batch, aabb, motion);
+	if (scalar.m_GameObject != NULL) { out_Hits++; }
+
+	Engine::SweptAABBBatch::Kernel kernels[2] = { Engine::SweptAABBBatch::Kernel::SSE2, Engine::SweptAABBBatch::Kernel::AVX2 };
+	for (Engine::SweptAABBBatch::Kernel kernel : kernels)
+	{
+		if (!Engine::SweptAABBBatch::IsSupported(kernel)) { continue; }
+		if (!IsIdentical(scalar, FindFirst(kernel, batch, aabb, motion))) { return false; }
+	}
+	return true;
+}
+
+// Fills a batch with the specified number of random candidates on a small grid (so candidates touch and share edges)
+void FillRandom(Engine::SweptAABBBatch& batch, size_t size, std::mt19937& random)
+{
+	std::uniform_int_distribution<int> cell(-8, 8);
+	std::uniform_int_distribution<int> extent(1, 4);
+	batch.Clear();
+	for (size_t i = 0; i < size; i++)
+	{
+		float x = float(cell(random)) * 4.0f;
+		float y = float(cell(random)) * 4.0f;
+		batch.Add(Engine::aabb2Df(x, x + float(extent(random)) * 4.0f, y, y + float(extent(random)) * 4.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[i]));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::mt19937 random(1234);
+	Engine::SweptAABBBatch batch;
+	Engine::SweptAABBBatch::Kernel selected = Engine::SweptAABBBatch::GetKernel();
+	std::cout << "SSE2 kernel " << (Engine::SweptAABBBatch::IsSupported(Engine::SweptAABBBatch::Kernel::SSE2) ? "supported" : "not supported, skipped") << std::endl;
+	std::cout << "AVX2 kernel " << (Engine::SweptAABBBatch::IsSupported(Engine::SweptAABBBatch::Kernel::AVX2) ? "supported" : "not supported, skipped") << std::endl;
+
+	// Moving AABB on the grid of the candidates, so it starts touching some of them
+	Engine::aabb2Df aabb(0.0f, 4.0f, 0.0f, 4.0f);
+
+test1:
+	{
+		// Random motions against batches of every size up to a few packets (including sizes that are not a multiple of 4 or 8)
+		bool passed = true;
+		size_t hits = 0;
+		std::uniform_real_distribution<float> motion(-40.0f, 40.0f);
+		for (size_t size = 0; size <= 37 && passed; size++)
+		{
+			for (int i = 0; i < 200 && passed; i++)
+			{
+				FillRandom(batch, size, random);
+				passed = TestKernels(batch, aabb, Engine::f2(motion(random), motion(random)), hits);
+			}
+		}
+		if (passed && hits > 0) { std::cout << "PASSED: Random motion (" << hits << " hits)" << std::endl; goto test2; }
+		else { std::cout << "FAILED: Random motion" << std::endl; goto test2; }
+	}
+
+test2:
+	{
+		// Zero and axis-aligned motion (divisions by zero produce infinite and NaN lambdas)
+		bool passed = true;
+		size_t hits = 0;
+		Engine::f2 motions[] =
+		{
+			Engine::f2(0.0f, 0.0f), Engine::f2(-0.0f, 0.0f),
+			Engine::f2(12.0f, 0.0f), Engine::f2(-12.0f, 0.0f), Engine::f2(0.0f, 12.0f), Engine::f2(0.0f, -12.0f),
+			Engine::f2(12.0f, -0.0f), Engine::f2(-0.0f, -12.0f),
+			Engine::f2(std::numeric_limits<float>::denorm_min(), 12.0f)
+		};
+		for (size_t size = 1; size <= 37 && passed; size++)
+		{
+			for (int i = 0; i < 50 && passed; i++)
+			{
+				FillRandom(batch, size, random);
+				for (const Engine::f2& m : motions) { if (!TestKernels(batch, aabb, m, hits)) { passed = false; break; } }
+			}
+		}
+		if (passed && hits > 0) { std::cout << "PASSED: Zero and axis-aligned motion (" << hits << " hits)" << std::endl; goto test3; }
+		else { std::cout << "FAILED: Zero and axis-aligned motion" << std::endl; goto test3; }
+	}
+
+test3:
+	{
+		// Candidates that touch the moving AABB at its edges and corners
+		bool passed = true;
+		size_t hits = 0;
+		batch.Clear();
+		batch.Add(Engine::aabb2Df(4.0f, 8.0f, 0.0f, 4.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[0]));
+		batch.Add(Engine::aabb2Df(-4.0f, 0.0f, 0.0f, 4.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[1]));
+		batch.Add(Engine::aabb2Df(0.0f, 4.0f, 4.0f, 8.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[2]));
+		batch.Add(Engine::aabb2Df(0.0f, 4.0f, -4.0f, 0.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[3]));
+		batch.Add(Engine::aabb2Df(4.0f, 8.0f, 4.0f, 8.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[4]));
+		Engine::f2 motions[] = { Engine::f2(1.0f, 0.0f), Engine::f2(-1.0f, 0.0f), Engine::f2(0.0f, 1.0f), Engine::f2(0.0f, -1.0f), Engine::f2(1.0f, 1.0f), Engine::f2(1.0f, -1.0f), Engine::f2(0.0f, 0.0f) };
+		for (const Engine::f2& m : motions) { if (!TestKernels(batch, aabb, m, hits)) { passed = false; break; } }
+		if (passed) { std::cout << "PASSED: Touching edges (" << hits << " hits)" << std::endl; goto test4; }
+		else { std::cout << "FAILED: Touching edges" << std::endl; goto test4; }
+	}
+
+test4:
+	{
+		// Candidates hit at exactly the same progression in different lanes and packets (the candidate added first is hit)
+		bool passed = true;
+		size_t hits = 0;
+		for (size_t size = 2; size <= 37 && passed; size++)
+		{
+			for (size_t first = 0; first < size && passed; first++)
+			{
+				batch.Clear();
+				for (size_t i = 0; i < size; i++)
+				{
+					float x = (i >= first && (i - first) % 3 == 0) ? 12.0f : 40.0f;
+					batch.Add(Engine::aabb2Df(x, x + 4.0f, 0.0f, 4.0f), reinterpret_cast<Engine::GameObject*>(&s_Candidates[i]));
+				}
+				passed = TestKernels(batch, aabb, Engine::f2(20.0f, 0.0f), hits);
+				if (passed)
+				{
+					Engine::f2 position, normal;
+					float progression;
+					passed = batch.FindFirst(aabb, Engine::f2(20.0f, 0.0f), position, normal, progression) == reinterpret_cast<Engine::GameObject*>(&s_Candidates[first]);
+				}
+			}
+		}
+		if (passed) { std::cout << "PASSED: Progression ties (" << hits << " hits)" << std::endl; goto end; }
+		else { std::cout << "FAILED: Progression ties" << std::endl; goto end; }
+	}
+
+end:
+	Engine::SweptAABBBatch::SetKernel(selected);
+	std::cin.get();
+	return 0;
+}